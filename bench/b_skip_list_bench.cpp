@@ -0,0 +1,114 @@
+#include "b_skip_list.hpp"
+#include "key_filter.hpp"
+#include "skip_list.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double timeIt(Fn fn) {
+    auto start = Clock::now();
+    fn();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Inserts, looks up and scans @p keys in @p list, printing the
+ * throughput of each phase.
+ */
+template <typename List>
+void run(const char *name, List &list, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &probes) {
+    const double n = static_cast<double>(keys.size());
+    double insert = timeIt([&] {
+        for (std::uint64_t key : keys) {
+            list.insert(key);
+        }
+    });
+    std::size_t found = 0;
+    double lookup = timeIt([&] {
+        for (std::uint64_t key : probes) {
+            found += list.contains(key);
+        }
+    });
+    std::uint64_t sum = 0;
+    double scan = timeIt([&] {
+        for (std::uint64_t key : list) {
+            sum += key;
+        }
+    });
+    // One key in 4 passes, at random: filtering after the iterator
+    // mispredicts, the pushed down filter does not branch
+    const auto filter = KeyFilter<std::uint64_t>().modulo(4, 1);
+    std::vector<std::uint64_t> kept;
+    kept.reserve(keys.size());
+    double iterate = timeIt([&] {
+        for (std::uint64_t key : list) {
+            if (filter(key)) {
+                kept.push_back(key);
+            }
+        }
+    });
+    std::vector<std::uint64_t> pushed;
+    pushed.reserve(keys.size());
+    double pushdown = timeIt([&] {
+        list.scanIf(0, std::numeric_limits<std::uint64_t>::max(), filter,
+                    [&](std::uint64_t key) { pushed.push_back(key); });
+    });
+    std::cout << name << ": insert " << n / insert / 1e6 << " M/s, lookup "
+              << probes.size() / lookup / 1e6 << " M/s (" << found
+              << " hits), scan " << n / scan / 1e6 << " M keys/s"
+              << " [checksum " << sum % 1000 << "]\n";
+    std::cout << "  filtered scan: iterator " << n / iterate / 1e6
+              << " M keys/s, scanIf " << n / pushdown / 1e6 << " M keys/s ("
+              << kept.size() << "/" << pushed.size() << " kept)\n";
+}
+
+} // namespace
+
+/**
+ * Compares the node-per-key SkipList with BSkipList on random 64-bit keys:
+ * insertion, point lookups (half of them hits), a full ordered scan and a
+ * scan keeping one key in 4, filtered after the iterator or by scanIf().
+ *
+ * Usage: b_skip_list_bench [KEYS]
+ */
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> keys(count);
+    for (auto &key : keys) {
+        key = rng();
+    }
+    std::vector<std::uint64_t> probes(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        probes[i] = i % 2 ? keys[rng() % count] : rng();
+    }
+
+    {
+        SkipList<std::uint64_t> list;
+        run("SkipList", list, keys, probes);
+    }
+    {
+        BSkipList<std::uint64_t, 16> list;
+        run("BSkipList<16>", list, keys, probes);
+    }
+    {
+        BSkipList<std::uint64_t, 32> list;
+        run("BSkipList<32>", list, keys, probes);
+    }
+    {
+        BSkipList<std::uint64_t, 64> list;
+        run("BSkipList<64>", list, keys, probes);
+    }
+    return 0;
+}
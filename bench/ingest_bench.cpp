@@ -0,0 +1,88 @@
+#include "buffered_skip_list.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Runs @p fn(thread) on @p threads threads and returns the seconds
+ * taken.
+ */
+template <typename Fn> double timeThreads(unsigned threads, Fn fn) {
+    auto start = Clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back(fn, t);
+    }
+    for (std::thread &th : pool) {
+        th.join();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+std::vector<std::uint64_t> makeKeys(std::size_t count, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::uint64_t> keys(count);
+    for (auto &key : keys) {
+        key = rng();
+    }
+    return keys;
+}
+
+} // namespace
+
+/**
+ * Loads random keys from several threads into a SkipList behind one mutex
+ * and into a BufferedSkipList, printing the insert throughput of both.
+ *
+ * Usage: ingest_bench [KEYS_PER_THREAD] [THREADS]
+ */
+int main(int argc, char **argv) {
+    std::size_t perThread = argc > 1 ? std::stoul(argv[1]) : 500000;
+    unsigned threads = argc > 2 ? std::stoul(argv[2]) : 4;
+
+    std::vector<std::vector<std::uint64_t>> keys;
+    for (unsigned t = 0; t < threads; ++t) {
+        keys.push_back(makeKeys(perThread, t + 1));
+    }
+    const double total = static_cast<double>(perThread) * threads;
+
+    SkipList<std::uint64_t> locked;
+    std::mutex mutex;
+    double lockedTime = timeThreads(threads, [&](unsigned t) {
+        for (std::uint64_t key : keys[t]) {
+            std::lock_guard<std::mutex> lock(mutex);
+            locked.insert(key);
+        }
+    });
+
+    for (std::size_t capacity : {256, 4096}) {
+        BufferedSkipList<std::uint64_t> buffered(capacity, threads);
+        double bufferedTime = timeThreads(threads, [&](unsigned t) {
+            for (std::uint64_t key : keys[t]) {
+                buffered.insert(key);
+            }
+        });
+        buffered.flush();
+        if (buffered.size() != locked.size()) {
+            std::cerr << "size mismatch\n";
+            return 1;
+        }
+        std::cout << "buffer " << capacity << ": "
+                  << total / bufferedTime / 1e6 << " M inserts/s, "
+                  << buffered.merges() << " merges\n";
+    }
+    std::cout << "mutex + insert: " << total / lockedTime / 1e6
+              << " M inserts/s\n";
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "checkpoint.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * Flushes a list of N random keys with each I/O backend and loads it back,
+ * printing the time of both phases.
+ *
+ * Usage: io_bench [N] [PATH]
+ */
+int main(int argc, char **argv) {
+    std::size_t n = argc > 1 ? std::stoull(argv[1]) : 2000000;
+    std::string path = argc > 2 ? argv[2] : "io_bench.ckpt";
+
+    SkipList<std::uint64_t> list;
+    std::mt19937_64 rng(1);
+    for (std::size_t i = 0; i < n; ++i) {
+        list.insert(rng());
+    }
+    std::cout << "keys: " << list.size() << '\n';
+
+    const IoBackend backends[] = {IoBackend::Blocking, IoBackend::Threaded,
+                                  IoBackend::Uring};
+    const char *names[] = {"blocking", "threaded", "io_uring"};
+    for (int i = 0; i < 3; ++i) {
+        // Uring runs as Threaded where io_uring is not available
+        std::string label = names[i];
+        IoBackend used = effectiveBackend(backends[i]);
+        if (used != backends[i]) {
+            label += std::string(" (fallback: ") +
+                     names[static_cast<int>(used)] + ')';
+        }
+        auto start = Clock::now();
+        bool saved = saveCheckpoint(list, path, backends[i]);
+        double saveTime = seconds(start);
+
+        SkipList<std::uint64_t> restored;
+        start = Clock::now();
+        bool loaded = loadCheckpoint(path, restored, backends[i]);
+        double loadTime = seconds(start);
+
+        if (!saved || !loaded || restored.size() != list.size()) {
+            std::cerr << label << ": round trip failed\n";
+            return 1;
+        }
+        std::cout << label << ":\tflush " << saveTime << " s, load "
+                  << loadTime << " s\n";
+    }
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "order_book.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Synthetic order flow: passive orders around a drifting mid price,
+ * cancels of random resting orders and occasional aggressive orders.
+ */
+struct Event {
+    enum Kind { Submit, Cancel } kind;
+    Order order;
+};
+
+std::vector<Event> generate(std::size_t count, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    std::geometric_distribution<int> offset(0.15);
+    std::uniform_int_distribution<std::uint64_t> qty(1, 100);
+
+    std::vector<Event> events;
+    std::vector<std::uint64_t> live;
+    std::int64_t mid = 100000;
+    std::uint64_t nextId = 1;
+
+    events.reserve(count);
+    while (events.size() < count) {
+        double r = coin(rng);
+        if (r < 0.45 && !live.empty()) {
+            std::size_t i = rng() % live.size();
+            events.push_back({Event::Cancel, {live[i], Side::Buy, 0, 0}});
+            live[i] = live.back();
+            live.pop_back();
+            continue;
+        }
+        if (r < 0.47) {
+            mid += coin(rng) < 0.5 ? -1 : 1;
+        }
+        Side side = coin(rng) < 0.5 ? Side::Buy : Side::Sell;
+        bool aggressive = r > 0.95;
+        std::int64_t distance = aggressive ? -offset(rng) : offset(rng) + 1;
+        std::int64_t price = side == Side::Buy ? mid - distance : mid + distance;
+        events.push_back({Event::Submit, {nextId, side, price, qty(rng)}});
+        live.push_back(nextId++);
+    }
+    return events;
+}
+
+} // namespace
+
+/**
+ * Replays a synthetic order stream through OrderBook and prints throughput
+ * and the latency distribution of single operations.
+ *
+ * Usage: order_book_bench [EVENTS]
+ */
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::stoull(argv[1]) : 2000000;
+    auto events = generate(count, 1);
+
+    OrderBook book;
+    std::vector<Trade> trades;
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve(events.size());
+    std::size_t executed = 0;
+
+    auto start = Clock::now();
+    for (const auto &event : events) {
+        auto t0 = Clock::now();
+        if (event.kind == Event::Submit) {
+            trades.clear();
+            book.submit(event.order, trades);
+            executed += trades.size();
+        } else {
+            book.cancel(event.order.id);
+        }
+        auto t1 = Clock::now();
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0)
+                .count());
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double q) {
+        return latencies[static_cast<std::size_t>(q * (latencies.size() - 1))];
+    };
+    std::cout << "events:     " << events.size() << " in " << elapsed.count()
+              << " s, " << events.size() / elapsed.count() << " ops/s\n";
+    std::cout << "trades:     " << executed << ", resting orders "
+              << book.orderCount() << ", levels " << book.bids().levelCount()
+              << " bid / " << book.asks().levelCount() << " ask\n";
+    std::cout << "latency ns: p50 " << percentile(0.5) << ", p99 "
+              << percentile(0.99) << ", p99.9 " << percentile(0.999)
+              << ", p99.99 " << percentile(0.9999) << ", max "
+              << latencies.back() << '\n';
+    return 0;
+}
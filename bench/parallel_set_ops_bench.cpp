@@ -0,0 +1,91 @@
+#include "parallel_set_ops.hpp"
+#include "posting_lists.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using List = SkipList<std::uint64_t>;
+
+List makeList(std::size_t count, std::uint64_t universe, std::mt19937_64 &rng) {
+    std::uniform_int_distribution<std::uint64_t> key(0, universe - 1);
+    std::vector<std::uint64_t> keys(count);
+    for (auto &k : keys) {
+        k = key(rng);
+    }
+    std::sort(keys.begin(), keys.end());
+    List list;
+    list.insertSorted(keys.begin(), keys.end());
+    return list;
+}
+
+template <typename Fn> double timeMs(Fn fn) {
+    auto start = Clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+} // namespace
+
+/**
+ * Unites and intersects two large lists sequentially (uniteLists() /
+ * intersectLists() followed by insertSorted()) and with the partitioned
+ * parallel operations on a growing number of threads, printing the times.
+ *
+ * Usage: parallel_set_ops_bench [KEYS_PER_LIST]
+ */
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937_64 rng(1);
+    List a = makeList(count, count * 4, rng);
+    List b = makeList(count, count * 4, rng);
+    std::vector<const List *> lists{&a, &b};
+
+    std::size_t united = 0;
+    std::size_t common = 0;
+    double uniteSeq = timeMs([&] {
+        std::vector<std::uint64_t> keys = uniteLists(lists);
+        List result;
+        result.insertSorted(keys.begin(), keys.end());
+        united = result.size();
+    });
+    double intersectSeq = timeMs([&] {
+        std::vector<std::uint64_t> keys = intersectLists(lists);
+        List result;
+        result.insertSorted(keys.begin(), keys.end());
+        common = result.size();
+    });
+    std::cout << "keys per list: " << count << ", union " << united
+              << ", intersection " << common << '\n';
+    std::cout << "sequential: union " << uniteSeq << " ms, intersection "
+              << intersectSeq << " ms\n";
+
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= 2 * cores; threads *= 2) {
+        double unite = timeMs([&] {
+            if (parallelUnite(lists, threads).size() != united) {
+                std::cerr << "union mismatch\n";
+                std::exit(1);
+            }
+        });
+        double intersect = timeMs([&] {
+            if (parallelIntersect(lists, threads).size() != common) {
+                std::cerr << "intersection mismatch\n";
+                std::exit(1);
+            }
+        });
+        std::cout << threads << " threads: union " << unite
+                  << " ms, intersection " << intersect << " ms\n";
+    }
+    return 0;
+}
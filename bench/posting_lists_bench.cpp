@@ -0,0 +1,118 @@
+#include "posting_lists.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using PostingList = SkipList<std::uint32_t>;
+
+PostingList makeList(std::uint32_t universe, double density,
+                     std::mt19937 &rng) {
+    std::bernoulli_distribution take(density);
+    std::vector<std::uint32_t> docs;
+    for (std::uint32_t doc = 0; doc < universe; ++doc) {
+        if (take(rng)) {
+            docs.push_back(doc);
+        }
+    }
+    PostingList list;
+    list.insertSorted(docs.begin(), docs.end());
+    return list;
+}
+
+/**
+ * @brief Baseline: intersects the lists pairwise by walking level 0 of both,
+ * smallest list first.
+ */
+std::vector<std::uint32_t>
+linearIntersect(std::vector<const PostingList *> lists) {
+    std::sort(lists.begin(), lists.end(),
+              [](const PostingList *a, const PostingList *b) {
+                  return a->size() < b->size();
+              });
+    std::vector<std::uint32_t> result(lists[0]->begin(), lists[0]->end());
+    for (std::size_t l = 1; l < lists.size() && !result.empty(); ++l) {
+        std::vector<std::uint32_t> next;
+        auto it = lists[l]->begin();
+        for (std::uint32_t doc : result) {
+            while (it != lists[l]->end() && *it < doc) {
+                ++it;
+            }
+            if (it == lists[l]->end()) {
+                break;
+            }
+            if (*it == doc) {
+                next.push_back(doc);
+            }
+        }
+        result.swap(next);
+    }
+    return result;
+}
+
+template <typename Fn> double timeQueries(int rounds, Fn fn) {
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        fn();
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count() / rounds * 1e6;
+}
+
+} // namespace
+
+/**
+ * Intersects posting lists of different densities with the finger-search
+ * engine and with a level-0 merge, printing the time per query.
+ *
+ * Usage: posting_lists_bench [UNIVERSE]
+ */
+int main(int argc, char **argv) {
+    std::uint32_t universe = argc > 1 ? std::stoul(argv[1]) : 4000000;
+    std::mt19937 rng(1);
+
+    const double densities[] = {0.5, 0.2, 0.05, 0.01, 0.001, 0.0001};
+    std::vector<PostingList> lists;
+    for (double d : densities) {
+        lists.push_back(makeList(universe, d, rng));
+    }
+
+    struct Query {
+        const char *name;
+        std::vector<int> terms;
+    };
+    const Query queries[] = {
+        {"dense & dense", {0, 1}},
+        {"dense & medium", {0, 2}},
+        {"dense & rare", {0, 4}},
+        {"dense & very rare", {0, 5}},
+        {"3 terms", {0, 1, 3}},
+        {"5 terms", {0, 1, 2, 3, 4}},
+    };
+
+    std::cout << "universe: " << universe << " docs\n";
+    for (const auto &q : queries) {
+        std::vector<const PostingList *> terms;
+        for (int t : q.terms) {
+            terms.push_back(&lists[t]);
+        }
+        std::size_t hits = intersectLists(terms).size();
+        if (hits != linearIntersect(terms).size()) {
+            std::cerr << "result mismatch for " << q.name << '\n';
+            return 1;
+        }
+        double finger = timeQueries(5, [&] { intersectLists(terms); });
+        double linear = timeQueries(5, [&] { linearIntersect(terms); });
+        std::cout << q.name << ": " << hits << " hits, finger " << finger
+                  << " us, linear " << linear << " us, speedup "
+                  << linear / finger << "x\n";
+    }
+    return 0;
+}
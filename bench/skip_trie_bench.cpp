@@ -0,0 +1,71 @@
+#include "skip_list.hpp"
+#include "skip_trie.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double timeIt(Fn fn) {
+    auto start = Clock::now();
+    fn();
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Times insertion of @p keys and lower_bound() of @p probes.
+ */
+template <typename Set>
+void run(const char *name, Set &set, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &probes) {
+    double insert = timeIt([&] {
+        for (std::uint64_t key : keys) {
+            set.insert(key);
+        }
+    });
+    std::uint64_t sum = 0;
+    double search = timeIt([&] {
+        for (std::uint64_t key : probes) {
+            auto it = set.lower_bound(key);
+            sum += it == set.end() ? 0 : *it;
+        }
+    });
+    std::cout << name << ": insert " << keys.size() / insert / 1e6
+              << " M/s, lower_bound " << probes.size() / search / 1e6
+              << " M/s [checksum " << sum % 1000 << "]\n";
+}
+
+} // namespace
+
+/**
+ * Compares successor searches on random 64-bit keys between SkipList and
+ * SkipTrie.
+ *
+ * Usage: skip_trie_bench [KEYS]
+ */
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 1000000;
+    std::mt19937_64 rng(5);
+    std::vector<std::uint64_t> keys(count);
+    for (auto &key : keys) {
+        key = rng();
+    }
+    std::vector<std::uint64_t> probes(count);
+    for (auto &key : probes) {
+        key = rng();
+    }
+
+    // Both stay alive so that neither is built in memory freed by the other
+    SkipList<std::uint64_t> list;
+    run("SkipList", list, keys, probes);
+    SkipTrie trie;
+    run("SkipTrie", trie, keys, probes);
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include "timer_service.hpp"
+
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Timeouts scheduled every tick, most of them cancelled before they
+ * expire, like request timeouts of a busy server.
+ */
+struct Workload {
+    std::uint64_t ticks;
+    std::vector<std::vector<std::pair<std::uint64_t, std::uint64_t>>>
+        schedules; ///< Per tick: (timer id, deadline)
+    std::vector<std::vector<std::uint64_t>> cancels; ///< Per tick: timer ids
+    std::uint64_t timers = 0;
+};
+
+Workload generate(std::uint64_t ticks, int perTick, double cancelRate) {
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<std::uint64_t> timeout(100, 10000);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+
+    Workload w{ticks, {}, {}};
+    w.schedules.resize(ticks);
+    w.cancels.resize(ticks + 10001);
+    for (std::uint64_t t = 0; t < ticks; ++t) {
+        for (int i = 0; i < perTick; ++i) {
+            std::uint64_t id = w.timers++;
+            std::uint64_t deadline = t + timeout(rng);
+            w.schedules[t].push_back({id, deadline});
+            if (coin(rng) < cancelRate) {
+                w.cancels[t + (deadline - t) * coin(rng)].push_back(id);
+            }
+        }
+    }
+    return w;
+}
+
+/**
+ * @brief Binary heap with lazy cancellation: a cancelled timer stays in the
+ * heap until it reaches the top.
+ */
+class HeapTimers {
+  public:
+    using Handle = std::uint64_t;
+
+    Handle schedule(std::uint64_t deadline, std::uint64_t id) {
+        if (live_.size() <= id) {
+            live_.resize(id + 1);
+        }
+        live_[id] = true;
+        heap_.push({deadline, id});
+        return id;
+    }
+
+    bool cancel(Handle id) {
+        bool was = live_[id];
+        live_[id] = false;
+        return was;
+    }
+
+    template <typename Visitor>
+    std::size_t popExpired(std::uint64_t now, Visitor visit) {
+        std::size_t fired = 0;
+        while (!heap_.empty() && heap_.top().first <= now) {
+            std::uint64_t id = heap_.top().second;
+            heap_.pop();
+            if (live_[id]) {
+                live_[id] = false;
+                visit(id);
+                ++fired;
+            }
+        }
+        return fired;
+    }
+
+  private:
+    using Entry = std::pair<std::uint64_t, std::uint64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+    std::vector<bool> live_;
+};
+
+/**
+ * @brief Hashed timing wheel with one slot per tick and doubly linked
+ * timer lists, so schedule and cancel are O(1).
+ */
+class WheelTimers {
+  public:
+    using Handle = std::uint64_t;
+
+    WheelTimers() : slots_(kSlots, kNone) {}
+
+    Handle schedule(std::uint64_t deadline, std::uint64_t id) {
+        if (nodes_.size() <= id) {
+            nodes_.resize(id + 1);
+        }
+        deadline = deadline < current_ ? current_ : deadline;
+        Timer &t = nodes_[id];
+        t = {deadline, kNone, slots_[deadline & (kSlots - 1)], true};
+        if (t.next != kNone) {
+            nodes_[t.next].prev = id;
+        }
+        slots_[deadline & (kSlots - 1)] = id;
+        return id;
+    }
+
+    bool cancel(Handle id) {
+        Timer &t = nodes_[id];
+        if (!t.armed) {
+            return false;
+        }
+        unlink(id);
+        return true;
+    }
+
+    template <typename Visitor>
+    std::size_t popExpired(std::uint64_t now, Visitor visit) {
+        std::size_t fired = 0;
+        for (; current_ <= now; ++current_) {
+            std::uint64_t id = slots_[current_ & (kSlots - 1)];
+            while (id != kNone) {
+                std::uint64_t next = nodes_[id].next;
+                if (nodes_[id].deadline == current_) {
+                    unlink(id);
+                    visit(id);
+                    ++fired;
+                }
+                id = next;
+            }
+        }
+        return fired;
+    }
+
+  private:
+    static constexpr std::uint64_t kSlots = 4096;
+    static constexpr std::uint64_t kNone = ~std::uint64_t{0};
+
+    struct Timer {
+        std::uint64_t deadline;
+        std::uint64_t prev;
+        std::uint64_t next;
+        bool armed;
+    };
+
+    void unlink(std::uint64_t id) {
+        Timer &t = nodes_[id];
+        if (t.prev == kNone) {
+            slots_[t.deadline & (kSlots - 1)] = t.next;
+        } else {
+            nodes_[t.prev].next = t.next;
+        }
+        if (t.next != kNone) {
+            nodes_[t.next].prev = t.prev;
+        }
+        t.armed = false;
+    }
+
+    std::vector<std::uint64_t> slots_;
+    std::vector<Timer> nodes_;
+    std::uint64_t current_ = 0;
+};
+
+template <typename Timers, typename Handle>
+void run(const char *name, Timers &timers, const Workload &w) {
+    std::vector<Handle> handles(w.timers);
+    std::size_t fired = 0;
+    std::size_t cancelled = 0;
+    auto count = [&](std::uint64_t) { ++fired; };
+
+    auto start = Clock::now();
+    for (std::uint64_t t = 0; t < w.cancels.size(); ++t) {
+        if (t < w.ticks) {
+            for (auto [id, deadline] : w.schedules[t]) {
+                handles[id] = timers.schedule(deadline, id);
+            }
+        }
+        for (std::uint64_t id : w.cancels[t]) {
+            cancelled += timers.cancel(handles[id]);
+        }
+        timers.popExpired(t, count);
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    std::cout << name << ": " << elapsed.count() << " s, "
+              << w.timers / elapsed.count() << " timers/s, fired " << fired
+              << ", cancelled " << cancelled << '\n';
+}
+
+} // namespace
+
+/**
+ * Runs the same schedule/cancel/expire stream through TimerService (exact
+ * and coarse), a binary heap and a timing wheel, printing the time taken.
+ *
+ * Usage: timer_bench [TICKS] [TIMERS_PER_TICK]
+ */
+int main(int argc, char **argv) {
+    std::uint64_t ticks = argc > 1 ? std::stoull(argv[1]) : 20000;
+    int perTick = argc > 2 ? std::stoi(argv[2]) : 100;
+    Workload w = generate(ticks, perTick, 0.9);
+    std::cout << "timers: " << w.timers << ", ticks: " << ticks << '\n';
+
+    {
+        TimerService timers;
+        run<TimerService, TimerHandle>("skip list      ", timers, w);
+    }
+    {
+        TimerService timers(64);
+        run<TimerService, TimerHandle>("skip list /64  ", timers, w);
+    }
+    {
+        HeapTimers timers;
+        run<HeapTimers, HeapTimers::Handle>("binary heap    ", timers, w);
+    }
+    {
+        WheelTimers timers;
+        run<WheelTimers, WheelTimers::Handle>("timing wheel   ", timers, w);
+    }
+    return 0;
+}
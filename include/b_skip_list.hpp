@@ -0,0 +1,407 @@
+#ifndef B_SKIP_LIST_HPP
+#define B_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+/**
+ * @brief Skip list whose levels are chains of key blocks (B-skiplist).
+ *
+ * Every level is a linked list of blocks holding up to @p B sorted keys;
+ * blocks above level 0 also hold, for each key, the pointer to the block
+ * one level down that starts with that key. A key promoted above a level
+ * (coin flips with probability p, about 2/B by default) starts a new block
+ * there, so the keys between two promoted keys form a run of about 1/p
+ * keys searched inside one or two blocks. A block that overflows is split
+ * in half; the second half is reached by moving right, like in a B-link
+ * tree.
+ *
+ * A search thus reads a few contiguous arrays per level instead of chasing
+ * one pointer per key, and a scan walks arrays of keys.
+ *
+ * @tparam Key type of key, must be LessThanComparable, default
+ * constructible and copy assignable
+ * @tparam B   capacity of a block in keys
+ */
+template <typename Key, int B = 32> class BSkipList {
+    static_assert(B >= 4 && B <= 65535, "unsupported block size");
+    static constexpr int kMaxLevel = 16;
+
+    struct Block {
+        Block *next = nullptr;
+        std::uint16_t count = 0;
+        Key keys[B];
+
+        std::size_t lowerBound(const Key &key) const {
+            return std::lower_bound(keys, keys + count, key) - keys;
+        }
+    };
+
+    /**
+     * @brief Block of a level above 0.
+     */
+    struct Inner : Block {
+        Block *down[B]; ///< Block one level down starting with keys[i]
+    };
+
+  public:
+    /**
+     * @brief Forward iterator over the keys in ascending order.
+     */
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key *;
+        using reference = const Key &;
+
+        Iterator() = default;
+        Iterator(const Block *block, std::size_t index)
+            : block_(block), index_(index) {}
+
+        reference operator*() const { return block_->keys[index_]; }
+        pointer operator->() const { return &block_->keys[index_]; }
+
+        Iterator &operator++() {
+            if (++index_ == block_->count) {
+                block_ = block_->next;
+                index_ = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return block_ == other.block_ && index_ == other.index_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+
+      private:
+        friend class BSkipList;
+
+        const Block *block_ = nullptr;
+        std::size_t index_ = 0;
+    };
+
+    /**
+     * @brief Constructs an empty list.
+     *
+     * @param probability Probability p of promoting a key to the next level
+     */
+    explicit BSkipList(double probability = 2.0 / B)
+        : probability_(probability),
+          rngState_(skip_list_detail::nextSeed()) {
+        heads_.fill(nullptr);
+        heads_[0] = new Block;
+    }
+
+    ~BSkipList() {
+        for (int l = 0; l < levels_; ++l) {
+            Block *b = heads_[l];
+            while (b) {
+                Block *next = b->next;
+                freeBlock(l, b);
+                b = next;
+            }
+        }
+    }
+
+    BSkipList(const BSkipList &) = delete;
+    BSkipList &operator=(const BSkipList &) = delete;
+
+    /**
+     * @brief Inserts a key.
+     *
+     * @return false if the key was already present.
+     */
+    bool insert(const Key &key) {
+        Path path;
+        if (locate(key, path)) {
+            return false;
+        }
+        int height = randomLevel();
+        for (; levels_ < height; ++levels_) {
+            heads_[levels_] = new Inner;
+            path[levels_] = {heads_[levels_], 0};
+        }
+
+        Block *below = nullptr; // Block one level down starting with key
+        for (int l = 0; l < height; ++l) {
+            auto [block, pos] =
+                insertAt(l, path[l].first, path[l].second, key, below);
+            if (l + 1 < height) {
+                // The key is promoted: its run starts a block of its own
+                below = pos == 0 && block != heads_[l]
+                            ? block
+                            : splitAt(l, block, pos);
+            }
+        }
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Removes a key.
+     *
+     * @return false if the key was not present.
+     */
+    bool erase(const Key &key) {
+        Path path;
+        if (!locate(key, path)) {
+            return false;
+        }
+        for (int l = 0; l < levels_; ++l) {
+            auto [block, pos] = path[l];
+            if (pos < block->count && !(key < block->keys[pos])) {
+                removeAt(l, block, pos);
+                continue;
+            }
+            Block *next = block->next;
+            if (pos != block->count || !next || key < next->keys[0]) {
+                break; // Above the top of the key's tower
+            }
+            // The key starts the next block: join its run to this one
+            removeAt(l, next, 0);
+            if (block->count + next->count <= B) {
+                moveKeys(l, next, 0, next->count, block, block->count);
+                block->count += next->count;
+                block->next = next->next;
+                freeBlock(l, next);
+            }
+        }
+        while (levels_ > 1 && heads_[levels_ - 1]->count == 0 &&
+               !heads_[levels_ - 1]->next) {
+            --levels_;
+            freeBlock(levels_, heads_[levels_]);
+            heads_[levels_] = nullptr;
+        }
+        --size_;
+        return true;
+    }
+
+    bool contains(const Key &key) const {
+        Iterator it = lower_bound(key);
+        return it != end() && !(key < *it);
+    }
+
+    /**
+     * @brief Returns an iterator to the first key not less than @p key.
+     */
+    Iterator lower_bound(const Key &key) const {
+        const Block *b = heads_[levels_ - 1];
+        for (int l = levels_ - 1;; --l) {
+            while (b->next && b->next->keys[0] < key) {
+                b = b->next;
+            }
+            std::size_t pos = b->lowerBound(key);
+            if (l == 0) {
+                if (pos == b->count) {
+                    return Iterator(b->next, 0);
+                }
+                return Iterator(b, pos);
+            }
+            b = pos > 0 ? static_cast<const Inner *>(b)->down[pos - 1]
+                        : heads_[l - 1];
+        }
+    }
+
+    /**
+     * @brief Calls visit(const Key &) in ascending order on the keys in
+     * [lo, hi) satisfying @p pred.
+     *
+     * @p pred is evaluated straight over the key arrays of the blocks,
+     * kScanBatch keys at a time, see skip_list_detail::matchMask(); no
+     * key is copied, and simple predicates such as KeyFilter vectorize.
+     *
+     * @return Number of matching keys.
+     */
+    template <typename Pred, typename Visitor>
+    std::size_t scanIf(const Key &lo, const Key &hi, Pred pred,
+                       Visitor visit) const {
+        using skip_list_detail::kScanBatch;
+        if (!(lo < hi)) {
+            return 0;
+        }
+        Iterator start = lower_bound(lo);
+        std::size_t from = start.index_;
+        std::size_t matches = 0;
+        for (const Block *b = start.block_; b; b = b->next, from = 0) {
+            std::size_t to = b->count;
+            bool last = !(b->keys[to - 1] < hi);
+            if (last) {
+                to = b->lowerBound(hi);
+            }
+            for (std::size_t i = from; i < to; i += kScanBatch) {
+                std::size_t n = std::min(kScanBatch, to - i);
+                std::uint64_t mask =
+                    skip_list_detail::matchMask(b->keys + i, n, pred);
+                matches += std::popcount(mask);
+                for (; mask; mask &= mask - 1) {
+                    visit(b->keys[i + std::countr_zero(mask)]);
+                }
+            }
+            if (last) {
+                break;
+            }
+        }
+        return matches;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Number of levels, level 0 included.
+     */
+    int levels() const { return levels_; }
+
+    Iterator begin() const {
+        const Block *head = heads_[0];
+        return head->count ? Iterator(head, 0) : Iterator(head->next, 0);
+    }
+    Iterator end() const { return Iterator(nullptr, 0); }
+
+  private:
+    /// Block and position of the key (or of its insertion point) per level
+    using Path = std::array<std::pair<Block *, std::size_t>, kMaxLevel>;
+
+    /**
+     * @brief Fills @p path with, at every level, the last block whose first
+     * key is less than @p key (or the head) and the position of @p key in
+     * it.
+     *
+     * @return true if the key is present.
+     */
+    bool locate(const Key &key, Path &path) const {
+        Block *b = heads_[levels_ - 1];
+        for (int l = levels_ - 1;; --l) {
+            while (b->next && b->next->keys[0] < key) {
+                b = b->next;
+            }
+            std::size_t pos = b->lowerBound(key);
+            path[l] = {b, pos};
+            if (l == 0) {
+                if (pos < b->count) {
+                    return !(key < b->keys[pos]);
+                }
+                return b->next && !(key < b->next->keys[0]);
+            }
+            b = pos > 0 ? static_cast<Inner *>(b)->down[pos - 1]
+                        : heads_[l - 1];
+        }
+    }
+
+    /**
+     * @brief Inserts @p key at @p pos of @p block, splitting a full block
+     * in half first.
+     *
+     * @return Block and position where the key ended up.
+     */
+    std::pair<Block *, std::size_t> insertAt(int level, Block *block,
+                                             std::size_t pos, const Key &key,
+                                             Block *down) {
+        if (block->count == B) {
+            constexpr std::size_t mid = B / 2;
+            Block *half = splitAt(level, block, mid);
+            if (pos > mid) {
+                block = half;
+                pos -= mid;
+            }
+        }
+        moveKeys(level, block, pos, block->count, block, pos + 1);
+        block->keys[pos] = key;
+        if (level > 0) {
+            static_cast<Inner *>(block)->down[pos] = down;
+        }
+        ++block->count;
+        return {block, pos};
+    }
+
+    /**
+     * @brief Moves the keys from @p pos on into a new block linked after
+     * @p block.
+     */
+    Block *splitAt(int level, Block *block, std::size_t pos) {
+        Block *tail = newBlock(level);
+        moveKeys(level, block, pos, block->count, tail, 0);
+        tail->count = static_cast<std::uint16_t>(block->count - pos);
+        block->count = static_cast<std::uint16_t>(pos);
+        tail->next = block->next;
+        block->next = tail;
+        return tail;
+    }
+
+    void removeAt(int level, Block *block, std::size_t pos) {
+        moveKeys(level, block, pos + 1, block->count, block, pos);
+        --block->count;
+    }
+
+    /**
+     * @brief Moves the keys [from, to) of @p src (and their down pointers)
+     * to @p dst starting at @p at; the ranges may overlap. Counts are left
+     * to the caller.
+     */
+    static void moveKeys(int level, Block *src, std::size_t from,
+                         std::size_t to, Block *dst, std::size_t at) {
+        if (from == to) {
+            return;
+        }
+        auto copy = [&](auto *source, auto *target) {
+            if (target + at > source + from) {
+                std::copy_backward(source + from, source + to,
+                                   target + at + (to - from));
+            } else {
+                std::copy(source + from, source + to, target + at);
+            }
+        };
+        copy(src->keys, dst->keys);
+        if (level > 0) {
+            copy(static_cast<Inner *>(src)->down,
+                 static_cast<Inner *>(dst)->down);
+        }
+    }
+
+    static Block *newBlock(int level) {
+        return level > 0 ? new Inner : new Block;
+    }
+
+    static void freeBlock(int level, Block *block) {
+        if (level > 0) {
+            delete static_cast<Inner *>(block);
+        } else {
+            delete block;
+        }
+    }
+
+    int randomLevel() {
+        int level = 1;
+        while (level < kMaxLevel && level < levels_ + 1 &&
+               skip_list_detail::toUnit(
+                   skip_list_detail::splitmix64(rngState_)) < probability_) {
+            ++level;
+        }
+        return level;
+    }
+
+    std::array<Block *, kMaxLevel> heads_; ///< First block of each level
+    int levels_ = 1;
+    std::size_t size_ = 0;
+    double probability_;
+    std::uint64_t rngState_;
+};
+
+#endif // B_SKIP_LIST_HPP
@@ -0,0 +1,855 @@
+#ifndef BLOCK_IO_HPP
+#define BLOCK_IO_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define SKIP_LIST_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+/**
+ * @brief I/O strategy used to flush and load list files block by block.
+ */
+enum class IoBackend {
+    Blocking, ///< write()/read() on the calling thread
+    Threaded, ///< Portable: a helper thread performs the I/O
+    Uring,    ///< io_uring with registered buffers (falls back to Threaded)
+};
+
+/**
+ * @brief Sequential writer of fixed-capacity blocks.
+ *
+ * The caller fills a buffer returned by acquire() and hands it back with
+ * submit(). Asynchronous backends keep several buffers, so the next block
+ * can be encoded while previous ones are still being written.
+ */
+class BlockWriter {
+  public:
+    virtual ~BlockWriter() = default;
+
+    /**
+     * @brief Returns a free buffer of blockSize() bytes.
+     *
+     * May wait for an in-flight write to release its buffer.
+     */
+    virtual char *acquire() = 0;
+
+    /**
+     * @brief Appends the first @p size bytes of the last acquired buffer to
+     * the file.
+     */
+    virtual void submit(std::size_t size) = 0;
+
+    /**
+     * @brief Waits for every submitted block and closes the file.
+     *
+     * @return false if any write failed.
+     */
+    virtual bool finish() = 0;
+
+    std::size_t blockSize() const { return blockSize_; }
+
+  protected:
+    explicit BlockWriter(std::size_t blockSize) : blockSize_(blockSize) {}
+
+    std::size_t blockSize_;
+};
+
+/**
+ * @brief Sequential reader of fixed-size blocks.
+ *
+ * Asynchronous backends read ahead several blocks while the caller decodes
+ * the current one.
+ */
+class BlockReader {
+  public:
+    virtual ~BlockReader() = default;
+
+    /**
+     * @brief Returns the next block of the file.
+     *
+     * The data stays valid until the following call. An empty span marks
+     * the end of the file or an error, see ok().
+     */
+    virtual std::span<const char> next() = 0;
+
+    /**
+     * @brief Whether every read so far succeeded.
+     */
+    bool ok() const { return ok_; }
+
+  protected:
+    BlockReader(int fd, std::size_t blockSize)
+        : fd_(fd), blockSize_(blockSize) {
+        struct stat st {};
+        if (fstat(fd, &st) == 0) {
+            fileSize_ = static_cast<std::uint64_t>(st.st_size);
+        }
+    }
+
+    /**
+     * @brief Length of block @p index, 0 past the end of the file.
+     */
+    std::size_t blockLength(std::uint64_t index) const {
+        std::uint64_t offset = index * blockSize_;
+        if (offset >= fileSize_) {
+            return 0;
+        }
+        std::uint64_t left = fileSize_ - offset;
+        return left < blockSize_ ? static_cast<std::size_t>(left) : blockSize_;
+    }
+
+    int fd_;
+    std::size_t blockSize_;
+    std::uint64_t fileSize_ = 0;
+    bool ok_ = true;
+};
+
+namespace block_io_detail {
+
+inline bool writeAll(int fd, const char *data, std::size_t size,
+                     std::uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+inline bool readAll(int fd, char *data, std::size_t size,
+                    std::uint64_t offset) {
+    while (size > 0) {
+        ssize_t n = pread(fd, data, size, static_cast<off_t>(offset));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+        offset += static_cast<std::uint64_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Page-aligned buffers of one block each.
+ */
+class BufferSet {
+  public:
+    static constexpr std::size_t kAlignment = 4096;
+
+    BufferSet(unsigned count, std::size_t size) : size_(size) {
+        for (unsigned i = 0; i < count; ++i) {
+            buffers_.emplace_back(static_cast<char *>(
+                ::operator new(size, std::align_val_t(kAlignment))));
+        }
+    }
+
+    char *operator[](unsigned i) const { return buffers_[i].get(); }
+    unsigned count() const { return static_cast<unsigned>(buffers_.size()); }
+    std::size_t size() const { return size_; }
+
+  private:
+    struct Free {
+        void operator()(char *p) const {
+            ::operator delete(p, std::align_val_t(kAlignment));
+        }
+    };
+
+    std::vector<std::unique_ptr<char, Free>> buffers_;
+    std::size_t size_;
+};
+
+class BlockingWriter : public BlockWriter {
+  public:
+    BlockingWriter(int fd, std::size_t blockSize)
+        : BlockWriter(blockSize), fd_(fd), buffers_(1, blockSize) {}
+
+    ~BlockingWriter() override { finish(); }
+
+    char *acquire() override { return buffers_[0]; }
+
+    void submit(std::size_t size) override {
+        ok_ = writeAll(fd_, buffers_[0], size, offset_) && ok_;
+        offset_ += size;
+    }
+
+    bool finish() override {
+        if (fd_ >= 0) {
+            ok_ = close(fd_) == 0 && ok_;
+            fd_ = -1;
+        }
+        return ok_;
+    }
+
+  private:
+    int fd_;
+    BufferSet buffers_;
+    std::uint64_t offset_ = 0;
+    bool ok_ = true;
+};
+
+/**
+ * @brief Writer handing blocks to a helper thread, used where io_uring is
+ * unavailable.
+ */
+class ThreadedWriter : public BlockWriter {
+  public:
+    ThreadedWriter(int fd, std::size_t blockSize, unsigned depth)
+        : BlockWriter(blockSize), fd_(fd), buffers_(depth, blockSize),
+          busy_(depth, false), worker_([this] { run(); }) {}
+
+    ~ThreadedWriter() override { finish(); }
+
+    char *acquire() override {
+        current_ = next_++ % buffers_.count();
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [&] { return !busy_[current_]; });
+        return buffers_[current_];
+    }
+
+    void submit(std::size_t size) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_[current_] = true;
+            queue_.push_back({current_, size, offset_});
+        }
+        offset_ += size;
+        pending_.notify_one();
+    }
+
+    bool finish() override {
+        if (!worker_.joinable()) {
+            return ok_;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        pending_.notify_one();
+        worker_.join();
+        ok_ = close(fd_) == 0 && ok_;
+        return ok_;
+    }
+
+  private:
+    struct Job {
+        unsigned buffer;
+        std::size_t size;
+        std::uint64_t offset;
+    };
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            pending_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            Job job = queue_.front();
+            queue_.pop_front();
+            lock.unlock();
+            bool ok = writeAll(fd_, buffers_[job.buffer], job.size, job.offset);
+            lock.lock();
+            ok_ = ok && ok_;
+            busy_[job.buffer] = false;
+            idle_.notify_one();
+        }
+    }
+
+    int fd_;
+    BufferSet buffers_;
+    std::uint64_t offset_ = 0;
+    unsigned next_ = 0;
+    unsigned current_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable pending_; ///< Signals queued jobs to the worker
+    std::condition_variable idle_;    ///< Signals released buffers
+    std::deque<Job> queue_;
+    std::vector<bool> busy_;
+    bool stop_ = false;
+    bool ok_ = true;
+    std::thread worker_;
+};
+
+class BlockingReader : public BlockReader {
+  public:
+    BlockingReader(int fd, std::size_t blockSize)
+        : BlockReader(fd, blockSize), buffers_(1, blockSize) {}
+
+    ~BlockingReader() override { close(fd_); }
+
+    std::span<const char> next() override {
+        std::size_t length = blockLength(block_);
+        if (length == 0 || !ok_) {
+            return {};
+        }
+        ok_ = readAll(fd_, buffers_[0], length, block_ * blockSize_);
+        ++block_;
+        return ok_ ? std::span<const char>(buffers_[0], length)
+                   : std::span<const char>();
+    }
+
+  private:
+    BufferSet buffers_;
+    std::uint64_t block_ = 0;
+};
+
+/**
+ * @brief Reader whose helper thread reads up to @c depth blocks ahead.
+ */
+class ThreadedReader : public BlockReader {
+  public:
+    ThreadedReader(int fd, std::size_t blockSize, unsigned depth)
+        : BlockReader(fd, blockSize), buffers_(depth, blockSize),
+          filled_(depth, false), worker_([this] { run(); }) {}
+
+    ~ThreadedReader() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        changed_.notify_all();
+        worker_.join();
+        close(fd_);
+    }
+
+    std::span<const char> next() override {
+        unsigned count = buffers_.count();
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (block_ > 0) {
+            filled_[(block_ - 1) % count] = false;
+            changed_.notify_all();
+        }
+        std::size_t length = blockLength(block_);
+        if (length == 0) {
+            return {};
+        }
+        unsigned idx = block_ % count;
+        changed_.wait(lock, [&] { return filled_[idx] || failed_; });
+        if (failed_) {
+            ok_ = false;
+            return {};
+        }
+        ++block_;
+        return {buffers_[idx], length};
+    }
+
+  private:
+    void run() {
+        unsigned count = buffers_.count();
+        for (std::uint64_t block = 0;; ++block) {
+            std::size_t length = blockLength(block);
+            if (length == 0) {
+                return;
+            }
+            unsigned idx = block % count;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                changed_.wait(lock, [&] { return stop_ || !filled_[idx]; });
+                if (stop_) {
+                    return;
+                }
+            }
+            bool ok = readAll(fd_, buffers_[idx], length, block * blockSize_);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                filled_[idx] = ok;
+                failed_ = !ok;
+            }
+            changed_.notify_all();
+            if (!ok) {
+                return;
+            }
+        }
+    }
+
+    BufferSet buffers_;
+    std::uint64_t block_ = 0; ///< Next block handed to the caller
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<bool> filled_;
+    bool failed_ = false;
+    bool stop_ = false;
+    std::thread worker_;
+};
+
+#ifdef SKIP_LIST_HAVE_IO_URING
+
+/**
+ * @brief Minimal io_uring instance driven through raw system calls.
+ *
+ * Supports the fixed-buffer read and write operations needed by the block
+ * reader and writer; every buffer of a BufferSet is registered once.
+ */
+class Uring {
+  public:
+    struct Completion {
+        std::uint64_t userData;
+        int result;
+    };
+
+    Uring(unsigned entries, const BufferSet &buffers) {
+        io_uring_params params{};
+        fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) {
+            return;
+        }
+
+        sqRingSize_ =
+            params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ =
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) {
+            sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+        }
+
+        sqRing_ = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        cqRing_ = single ? sqRing_
+                         : mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE,
+                                MAP_SHARED | MAP_POPULATE, fd_,
+                                IORING_OFF_CQ_RING);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe *>(
+            mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+        if (sqRing_ == MAP_FAILED || cqRing_ == MAP_FAILED ||
+            sqes_ == MAP_FAILED) {
+            release();
+            return;
+        }
+
+        auto *sq = static_cast<char *>(sqRing_);
+        sqTail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+        auto *cq = static_cast<char *>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        std::vector<iovec> iovs(buffers.count());
+        for (unsigned i = 0; i < buffers.count(); ++i) {
+            iovs[i] = {buffers[i], buffers.size()};
+        }
+        if (syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS,
+                    iovs.data(), static_cast<unsigned>(iovs.size())) < 0) {
+            release();
+        }
+    }
+
+    ~Uring() { release(); }
+
+    Uring(const Uring &) = delete;
+    Uring &operator=(const Uring &) = delete;
+
+    bool valid() const { return fd_ >= 0; }
+
+    /**
+     * @brief Queues and submits one fixed-buffer read or write.
+     *
+     * @return false if the kernel did not accept the request; no
+     * completion will then be posted for it.
+     */
+    bool submit(std::uint8_t opcode, int fd, char *buf, unsigned bufIndex,
+                std::size_t length, std::uint64_t offset,
+                std::uint64_t userData) {
+        unsigned tail = *sqTail_;
+        unsigned idx = tail & sqMask_;
+        io_uring_sqe &sqe = sqes_[idx];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<std::uint64_t>(buf);
+        sqe.len = static_cast<unsigned>(length);
+        sqe.off = offset;
+        sqe.buf_index = static_cast<std::uint16_t>(bufIndex);
+        sqe.user_data = userData;
+        sqArray_[idx] = idx;
+        std::atomic_ref<unsigned>(*sqTail_).store(tail + 1,
+                                                  std::memory_order_release);
+        int submitted;
+        do {
+            submitted = enter(1, 0);
+        } while (submitted < 0 && (errno == EINTR || errno == EAGAIN));
+        if (submitted == 1) {
+            return true;
+        }
+        // Withdraw the entry the kernel did not take, so that a later
+        // enter() cannot submit it behind the caller's back
+        std::atomic_ref<unsigned>(*sqTail_).store(tail,
+                                                  std::memory_order_release);
+        return false;
+    }
+
+    /**
+     * @brief Waits for the next completion.
+     */
+    bool wait(Completion &out) {
+        for (;;) {
+            unsigned head = *cqHead_;
+            unsigned tail = std::atomic_ref<unsigned>(*cqTail_).load(
+                std::memory_order_acquire);
+            if (head != tail) {
+                const io_uring_cqe &cqe = cqes_[head & cqMask_];
+                out = {cqe.user_data, cqe.res};
+                std::atomic_ref<unsigned>(*cqHead_).store(
+                    head + 1, std::memory_order_release);
+                return true;
+            }
+            if (enter(0, 1) < 0 && errno != EINTR) {
+                return false;
+            }
+        }
+    }
+
+  private:
+    int enter(unsigned toSubmit, unsigned minComplete) {
+        unsigned flags = minComplete ? IORING_ENTER_GETEVENTS : 0;
+        return static_cast<int>(syscall(__NR_io_uring_enter, fd_, toSubmit,
+                                        minComplete, flags, nullptr, 0));
+    }
+
+    void release() {
+        if (sqes_ && sqes_ != MAP_FAILED) {
+            munmap(sqes_, sqesSize_);
+        }
+        if (cqRing_ && cqRing_ != MAP_FAILED && cqRing_ != sqRing_) {
+            munmap(cqRing_, cqRingSize_);
+        }
+        if (sqRing_ && sqRing_ != MAP_FAILED) {
+            munmap(sqRing_, sqRingSize_);
+        }
+        sqes_ = nullptr;
+        sqRing_ = cqRing_ = nullptr;
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd_ = -1;
+    void *sqRing_ = nullptr;
+    void *cqRing_ = nullptr;
+    io_uring_sqe *sqes_ = nullptr;
+    std::size_t sqRingSize_ = 0;
+    std::size_t cqRingSize_ = 0;
+    std::size_t sqesSize_ = 0;
+
+    unsigned *sqTail_ = nullptr;
+    unsigned *sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned *cqHead_ = nullptr;
+    unsigned *cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe *cqes_ = nullptr;
+};
+
+class UringWriter : public BlockWriter {
+  public:
+    UringWriter(int fd, std::size_t blockSize, unsigned depth)
+        : BlockWriter(blockSize), fd_(fd), buffers_(depth, blockSize),
+          ring_(depth, buffers_), inFlight_(depth, 0), offsets_(depth, 0) {}
+
+    ~UringWriter() override { finish(); }
+
+    bool valid() const { return ring_.valid(); }
+
+    /**
+     * @brief Gives up ownership of the file descriptor.
+     */
+    int releaseFd() { return std::exchange(fd_, -1); }
+
+    char *acquire() override {
+        current_ = next_++ % buffers_.count();
+        while (inFlight_[current_] && reapOne()) {
+        }
+        return buffers_[current_];
+    }
+
+    void submit(std::size_t size) override {
+        inFlight_[current_] = size;
+        offsets_[current_] = offset_;
+        if (!ring_.submit(IORING_OP_WRITE_FIXED, fd_, buffers_[current_],
+                          current_, size, offset_, current_)) {
+            // Nothing will complete for this buffer: write it synchronously
+            inFlight_[current_] = 0;
+            ok_ = writeAll(fd_, buffers_[current_], size, offset_) && ok_;
+        }
+        offset_ += size;
+    }
+
+    bool finish() override {
+        if (fd_ < 0) {
+            return ok_;
+        }
+        for (unsigned i = 0; i < buffers_.count(); ++i) {
+            while (inFlight_[i] && reapOne()) {
+            }
+        }
+        ok_ = close(fd_) == 0 && ok_;
+        fd_ = -1;
+        return ok_;
+    }
+
+  private:
+    /**
+     * @brief Handles one completion; short writes are finished
+     * synchronously.
+     */
+    bool reapOne() {
+        Uring::Completion c;
+        if (!ring_.wait(c)) {
+            ok_ = false;
+            std::fill(inFlight_.begin(), inFlight_.end(), 0);
+            return false;
+        }
+        auto idx = static_cast<unsigned>(c.userData);
+        std::size_t size = inFlight_[idx];
+        if (c.result < 0) {
+            ok_ = false;
+        } else if (static_cast<std::size_t>(c.result) < size) {
+            auto done = static_cast<std::size_t>(c.result);
+            ok_ = writeAll(fd_, buffers_[idx] + done, size - done,
+                           offsets_[idx] + done) &&
+                  ok_;
+        }
+        inFlight_[idx] = 0;
+        return true;
+    }
+
+    int fd_;
+    BufferSet buffers_;
+    Uring ring_;
+    std::vector<std::size_t> inFlight_; ///< Bytes in flight per buffer
+    std::vector<std::uint64_t> offsets_;
+    std::uint64_t offset_ = 0;
+    unsigned next_ = 0;
+    unsigned current_ = 0;
+    bool ok_ = true;
+};
+
+class UringReader : public BlockReader {
+  public:
+    UringReader(int fd, std::size_t blockSize, unsigned depth)
+        : BlockReader(fd, blockSize), buffers_(depth, blockSize),
+          ring_(depth, buffers_), done_(depth) {
+        if (!ring_.valid()) {
+            return;
+        }
+        for (unsigned i = 0; i < depth; ++i) {
+            issue(i);
+        }
+    }
+
+    ~UringReader() override {
+        while (pending_ > 0) {
+            Uring::Completion c;
+            if (!ring_.wait(c)) {
+                break;
+            }
+            --pending_;
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    bool valid() const { return ring_.valid(); }
+
+    /**
+     * @brief Gives up ownership of the file descriptor.
+     */
+    int releaseFd() { return std::exchange(fd_, -1); }
+
+    std::span<const char> next() override {
+        unsigned count = buffers_.count();
+        if (block_ > 0) {
+            issue(block_ - 1 + count);
+        }
+        std::size_t length = blockLength(block_);
+        if (length == 0 || !ok_) {
+            return {};
+        }
+        unsigned idx = block_ % count;
+        while (!done_[idx]) {
+            Uring::Completion c;
+            if (!ring_.wait(c)) {
+                ok_ = false;
+                return {};
+            }
+            --pending_;
+            done_[static_cast<unsigned>(c.userData)] = c.result;
+        }
+        int result = *std::exchange(done_[idx], std::nullopt);
+        if (result < 0) {
+            ok_ = false;
+            return {};
+        }
+        auto got = static_cast<std::size_t>(result);
+        if (got < length) {
+            ok_ = readAll(fd_, buffers_[idx] + got, length - got,
+                          block_ * blockSize_ + got);
+        }
+        ++block_;
+        return ok_ ? std::span<const char>(buffers_[idx], length)
+                   : std::span<const char>();
+    }
+
+  private:
+    void issue(std::uint64_t block) {
+        std::size_t length = blockLength(block);
+        if (length == 0) {
+            return;
+        }
+        unsigned idx = block % buffers_.count();
+        if (!ring_.submit(IORING_OP_READ_FIXED, fd_, buffers_[idx], idx, length,
+                          block * blockSize_, idx)) {
+            // Nothing will complete for this buffer: read it synchronously
+            done_[idx] = readAll(fd_, buffers_[idx], length, block * blockSize_)
+                             ? static_cast<int>(length)
+                             : -EIO;
+            return;
+        }
+        ++pending_;
+    }
+
+    BufferSet buffers_;
+    Uring ring_;
+    /// Completion result per buffer (a negative errno on failure), empty
+    /// while the read is pending
+    std::vector<std::optional<int>> done_;
+    std::uint64_t block_ = 0;
+    unsigned pending_ = 0;
+};
+
+#endif // SKIP_LIST_HAVE_IO_URING
+
+} // namespace block_io_detail
+
+/**
+ * @brief Returns the backend makeBlockWriter() and makeBlockReader() use
+ * when asked for @p backend: Threaded in place of an unavailable Uring.
+ */
+inline IoBackend effectiveBackend(IoBackend backend) {
+    if (backend != IoBackend::Uring) {
+        return backend;
+    }
+#ifdef SKIP_LIST_HAVE_IO_URING
+    using block_io_detail::BufferSet;
+    BufferSet buffers(1, BufferSet::kAlignment);
+    if (block_io_detail::Uring(1, buffers).valid()) {
+        return backend;
+    }
+#endif
+    return IoBackend::Threaded;
+}
+
+/**
+ * @brief Creates a writer that truncates or creates @p path.
+ *
+ * @param backend   I/O strategy; Uring falls back to Threaded when io_uring
+ * is not available
+ * @param blockSize Capacity of every buffer in bytes
+ * @param depth     Number of buffers in flight for asynchronous backends
+ * @return The writer, or nullptr if the file cannot be opened.
+ */
+inline std::unique_ptr<BlockWriter>
+makeBlockWriter(const std::string &path, IoBackend backend,
+                std::size_t blockSize = 1 << 20, unsigned depth = 4) {
+    using namespace block_io_detail;
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (depth == 0) {
+        depth = 1;
+    }
+#ifdef SKIP_LIST_HAVE_IO_URING
+    if (backend == IoBackend::Uring) {
+        auto writer = std::make_unique<UringWriter>(fd, blockSize, depth);
+        if (writer->valid()) {
+            return writer;
+        }
+        fd = writer->releaseFd();
+    }
+#endif
+    if (backend == IoBackend::Blocking) {
+        return std::make_unique<BlockingWriter>(fd, blockSize);
+    }
+    return std::make_unique<ThreadedWriter>(fd, blockSize, depth);
+}
+
+/**
+ * @brief Creates a reader of @p path.
+ *
+ * @return The reader, or nullptr if the file cannot be opened.
+ * @see makeBlockWriter()
+ */
+inline std::unique_ptr<BlockReader>
+makeBlockReader(const std::string &path, IoBackend backend,
+                std::size_t blockSize = 1 << 20, unsigned depth = 4) {
+    using namespace block_io_detail;
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    if (depth == 0) {
+        depth = 1;
+    }
+#ifdef SKIP_LIST_HAVE_IO_URING
+    if (backend == IoBackend::Uring) {
+        auto reader = std::make_unique<UringReader>(fd, blockSize, depth);
+        if (reader->valid()) {
+            return reader;
+        }
+        fd = reader->releaseFd();
+    }
+#endif
+    if (backend == IoBackend::Blocking) {
+        return std::make_unique<BlockingReader>(fd, blockSize);
+    }
+    return std::make_unique<ThreadedReader>(fd, blockSize, depth);
+}
+
+#endif // BLOCK_IO_HPP
@@ -0,0 +1,232 @@
+#ifndef BUFFERED_SKIP_LIST_HPP
+#define BUFFERED_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread-safe set that takes writes into per-thread buffers and
+ * merges them into a SkipList in batches.
+ *
+ * insert() and erase() only record the operation, stamped with a global
+ * sequence number, in the small sorted buffer of the calling thread, so
+ * writers neither search the list nor contend on a shared lock. When a
+ * buffer fills up, or on flush(), every buffer is drained: the operations
+ * are sorted by key and sequence number, only the last one of each key is
+ * kept, and the inserts are applied through SkipList::insertSorted() under
+ * one exclusive lock. A merge locks all buffers before it drains any, so
+ * it takes a consistent cut: every operation numbered before it started,
+ * none numbered after. Otherwise an older operation recorded in a buffer
+ * already drained could outlive a newer one on the same key merged from a
+ * buffer drained later.
+ *
+ * contains() looks at the buffers first, where the operation with the
+ * highest sequence number wins, and at the list otherwise. A merge holds
+ * the list lock exclusively from the moment it drains the buffers until
+ * it has applied them, so a lookup always sees each operation either in a
+ * buffer or in the list.
+ *
+ * @tparam Key type of key, must be LessThanComparable and copyable
+ */
+template <typename Key> class BufferedSkipList {
+  public:
+    /**
+     * @param bufferCapacity Operations a buffer holds before it triggers a
+     * merge
+     * @param buffers        Number of buffers; threads are spread over them,
+     * so with at least one buffer per thread no two writers share one
+     */
+    explicit BufferedSkipList(
+        std::size_t bufferCapacity = 256,
+        std::size_t buffers = std::max(1u, std::thread::hardware_concurrency()))
+        : capacity_(bufferCapacity ? bufferCapacity : 1) {
+        buffers_.resize(buffers ? buffers : 1);
+        for (auto &buffer : buffers_) {
+            buffer = std::make_unique<Buffer>();
+        }
+    }
+
+    BufferedSkipList(const BufferedSkipList &) = delete;
+    BufferedSkipList &operator=(const BufferedSkipList &) = delete;
+
+    /**
+     * @brief Records the insertion of @p key.
+     */
+    void insert(const Key &key) { record(key, false); }
+
+    /**
+     * @brief Records the removal of @p key.
+     */
+    void erase(const Key &key) { record(key, true); }
+
+    bool contains(const Key &key) const {
+        std::shared_lock<std::shared_mutex> lock(listMutex_);
+        bool found = false;
+        Op latest{key, 0, false};
+        for (const auto &buffer : buffers_) {
+            std::lock_guard<std::mutex> guard(buffer->mutex);
+            const Op *op = buffer->find(key);
+            if (op && (!found || op->seq > latest.seq)) {
+                latest = *op;
+                found = true;
+            }
+        }
+        if (found) {
+            return !latest.erase;
+        }
+        return list_.contains(key);
+    }
+
+    /**
+     * @brief Merges every buffered operation into the list.
+     */
+    void flush() {
+        std::unique_lock<std::shared_mutex> lock(listMutex_);
+        merge();
+    }
+
+    /**
+     * @brief Calls visit(const Key &) on the keys in ascending order, after
+     * merging the buffers.
+     */
+    template <typename Visitor> void forEach(Visitor visit) {
+        flush();
+        std::shared_lock<std::shared_mutex> lock(listMutex_);
+        for (const Key &key : list_) {
+            visit(key);
+        }
+    }
+
+    /**
+     * @brief Number of keys, after merging the buffers.
+     */
+    std::size_t size() {
+        flush();
+        std::shared_lock<std::shared_mutex> lock(listMutex_);
+        return list_.size();
+    }
+
+    /**
+     * @brief Number of merges made so far.
+     */
+    std::size_t merges() const {
+        return merges_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    struct Op {
+        Key key;
+        std::uint64_t seq;
+        bool erase;
+    };
+
+    /**
+     * @brief Latest operation of each key recorded by a thread, sorted by
+     * key.
+     */
+    struct Buffer {
+        std::mutex mutex;
+        std::vector<Op> ops;
+
+        const Op *find(const Key &key) const {
+            auto it = lowerBound(ops, key);
+            return it != ops.end() && !(key < it->key) ? &*it : nullptr;
+        }
+
+        template <typename Ops>
+        static auto lowerBound(Ops &ops, const Key &key) {
+            return std::lower_bound(
+                ops.begin(), ops.end(), key,
+                [](const Op &op, const Key &k) { return op.key < k; });
+        }
+    };
+
+    void record(const Key &key, bool erase) {
+        Buffer &buffer = *buffers_[bufferIndex() % buffers_.size()];
+        bool full;
+        {
+            std::lock_guard<std::mutex> guard(buffer.mutex);
+            // Numbered under the buffer lock, so that threads sharing the
+            // buffer replace each other's operations in sequence order
+            Op op{key, seq_.fetch_add(1, std::memory_order_relaxed), erase};
+            auto it = Buffer::lowerBound(buffer.ops, key);
+            if (it != buffer.ops.end() && !(key < it->key)) {
+                *it = op;
+            } else {
+                buffer.ops.insert(it, op);
+            }
+            full = buffer.ops.size() >= capacity_;
+        }
+        if (full) {
+            flush();
+        }
+    }
+
+    /**
+     * @brief Drains every buffer into the list. Called with listMutex_ held
+     * exclusively.
+     */
+    void merge() {
+        // Every buffer is locked, in index order, before any is drained
+        std::vector<std::unique_lock<std::mutex>> guards;
+        guards.reserve(buffers_.size());
+        for (const auto &buffer : buffers_) {
+            guards.emplace_back(buffer->mutex);
+        }
+        std::vector<Op> ops;
+        for (const auto &buffer : buffers_) {
+            ops.insert(ops.end(), buffer->ops.begin(), buffer->ops.end());
+            buffer->ops.clear();
+        }
+        guards.clear();
+        if (ops.empty()) {
+            return;
+        }
+        std::sort(ops.begin(), ops.end(), [](const Op &a, const Op &b) {
+            if (a.key < b.key) {
+                return true;
+            }
+            return !(b.key < a.key) && a.seq < b.seq;
+        });
+
+        std::vector<Key> inserts;
+        for (std::size_t i = 0; i < ops.size(); ++i) {
+            bool last = i + 1 == ops.size() || ops[i].key < ops[i + 1].key;
+            if (!last) {
+                continue;
+            }
+            if (ops[i].erase) {
+                list_.erase(ops[i].key);
+            } else {
+                inserts.push_back(ops[i].key);
+            }
+        }
+        list_.insertSorted(inserts.begin(), inserts.end());
+        merges_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::size_t bufferIndex() {
+        static std::atomic<std::size_t> threads{0};
+        thread_local std::size_t index = threads.fetch_add(1);
+        return index;
+    }
+
+    std::size_t capacity_;
+    std::vector<std::unique_ptr<Buffer>> buffers_;
+    std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::size_t> merges_{0};
+
+    mutable std::shared_mutex listMutex_;
+    SkipList<Key> list_;
+};
+
+#endif // BUFFERED_SKIP_LIST_HPP
@@ -0,0 +1,147 @@
+#ifndef CHANGE_STREAM_HPP
+#define CHANGE_STREAM_HPP
+
+#include "skip_list.hpp"
+#include "spsc_ring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Kind of a captured mutation.
+ */
+enum class ChangeOp : std::uint8_t { Insert, Erase };
+
+/**
+ * @brief One captured mutation of a SkipList.
+ */
+template <typename Key> struct ChangeEvent {
+    std::uint64_t seq; ///< Position in the stream, starting at 1
+    ChangeOp op;
+    Key key;
+};
+
+/**
+ * @brief Change-data-capture stream between a leader and a follower list.
+ *
+ * Attached to the leader with SkipList::setChangeSink(), the stream records
+ * every insert and erase as a sequence-numbered ChangeEvent in a lock-free
+ * SPSC ring. Another thread drains the ring in batches and replays them on a
+ * follower: consecutive inserts are sorted and applied through
+ * SkipList::insertSorted(), erases are applied one by one, so the follower
+ * converges to the leader's state after every drained batch.
+ *
+ * The leader's writes must be serialized (the stream is the single producer)
+ * and exactly one thread may consume. When the ring is full the writer
+ * yields until the consumer frees space.
+ *
+ * @tparam Key type of key of the observed list
+ */
+template <typename Key> class ChangeStream : public ChangeSink<Key> {
+  public:
+    using Event = ChangeEvent<Key>;
+
+    /**
+     * @brief Creates a stream buffering up to @p capacity events.
+     */
+    explicit ChangeStream(std::size_t capacity = 1 << 16) : ring_(capacity) {}
+
+    void onInsert(const Key &key) override { push(ChangeOp::Insert, key); }
+    void onErase(const Key &key) override { push(ChangeOp::Erase, key); }
+
+    /**
+     * @brief Moves up to @p max pending events into @p out (consumer side).
+     *
+     * @return Number of events appended to @p out.
+     */
+    std::size_t poll(std::vector<Event> &out, std::size_t max = 4096) {
+        std::size_t old = out.size();
+        out.resize(old + max);
+        std::size_t count = ring_.popBatch(out.data() + old, max);
+        out.resize(old + count);
+        if (count) {
+            assert(out[old].seq ==
+                   consumedSeq_.load(std::memory_order_relaxed) + 1);
+            consumedSeq_.store(out.back().seq, std::memory_order_release);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Drains up to @p max pending events and applies them to
+     * @p follower (consumer side).
+     *
+     * @return Number of events applied.
+     */
+    std::size_t applyTo(SkipList<Key> &follower, std::size_t max = 4096) {
+        batch_.clear();
+        std::size_t count = poll(batch_, max);
+        applyEvents(batch_.begin(), batch_.end(), follower, run_);
+        return count;
+    }
+
+    /**
+     * @brief Replays a sequence of events on @p list.
+     *
+     * Runs of inserts are sorted and inserted with SkipList::insertSorted();
+     * @p scratch is reused as the buffer for those runs.
+     */
+    template <typename It>
+    static void applyEvents(It first, It last, SkipList<Key> &list,
+                            std::vector<Key> &scratch) {
+        scratch.clear();
+        auto flushRun = [&] {
+            std::sort(scratch.begin(), scratch.end());
+            list.insertSorted(scratch.begin(), scratch.end());
+            scratch.clear();
+        };
+        for (; first != last; ++first) {
+            if (first->op == ChangeOp::Insert) {
+                scratch.push_back(first->key);
+                continue;
+            }
+            flushRun();
+            list.erase(first->key);
+        }
+        flushRun();
+    }
+
+    /**
+     * @brief Sequence number of the last event produced by the leader; may
+     * be read from any thread.
+     */
+    std::uint64_t producedSeq() const {
+        return producedSeq_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Sequence number of the last event taken by the consumer; may
+     * be read from any thread.
+     */
+    std::uint64_t consumedSeq() const {
+        return consumedSeq_.load(std::memory_order_acquire);
+    }
+
+  private:
+    void push(ChangeOp op, const Key &key) {
+        std::uint64_t seq = producedSeq_.load(std::memory_order_relaxed) + 1;
+        producedSeq_.store(seq, std::memory_order_release);
+        Event event{seq, op, key};
+        while (!ring_.tryPush(event)) {
+            std::this_thread::yield();
+        }
+    }
+
+    SpscRing<Event> ring_;
+    std::atomic<std::uint64_t> producedSeq_{0}; ///< Written by the producer
+    std::atomic<std::uint64_t> consumedSeq_{0}; ///< Written by the consumer
+    std::vector<Event> batch_; ///< Consumer's scratch batch
+    std::vector<Key> run_;     ///< Consumer's scratch insert run
+};
+
+#endif // CHANGE_STREAM_HPP
@@ -0,0 +1,383 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "block_io.hpp"
+#include "change_stream.hpp"
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Checkpoint file format shared by Checkpointer and loadCheckpoint().
+ *
+ * A checkpoint is an 8-byte magic followed by records of one op byte and the
+ * raw bytes of a key. Replaying the records in order on an empty list
+ * reproduces the checkpointed state.
+ */
+namespace checkpoint_format {
+
+inline constexpr char kMagic[8] = {'S', 'L', 'C', 'K', 'P', 'T', '1', '\0'};
+
+/**
+ * @brief Encodes records into the blocks of a BlockWriter.
+ *
+ * A block is handed to the writer as soon as the next record does not fit,
+ * so with an asynchronous backend encoding continues while it is written.
+ */
+template <typename Key> class RecordWriter {
+  public:
+    static constexpr std::size_t kRecordSize = 1 + sizeof(Key);
+
+    explicit RecordWriter(BlockWriter &out) : out_(out), buf_(out.acquire()) {
+        assert(out.blockSize() >= sizeof(kMagic) + kRecordSize);
+        std::memcpy(buf_, kMagic, sizeof(kMagic));
+        fill_ = sizeof(kMagic);
+    }
+
+    void write(ChangeOp op, const Key &key) {
+        if (fill_ + kRecordSize > out_.blockSize()) {
+            out_.submit(fill_);
+            buf_ = out_.acquire();
+            fill_ = 0;
+        }
+        buf_[fill_] = static_cast<char>(op);
+        std::memcpy(buf_ + fill_ + 1, &key, sizeof(Key));
+        fill_ += kRecordSize;
+    }
+
+    /**
+     * @brief Submits the last block and waits for all writes.
+     */
+    bool finish() {
+        out_.submit(fill_);
+        return out_.finish();
+    }
+
+  private:
+    BlockWriter &out_;
+    char *buf_;
+    std::size_t fill_ = 0;
+};
+
+/**
+ * @brief Decodes every record of a checkpoint file.
+ *
+ * Records may straddle block boundaries; their bytes are reassembled in a
+ * small carry buffer.
+ *
+ * @param visit Called as visit(ChangeOp, const Key &) for every record
+ * @return false if the file is malformed or a read failed.
+ */
+template <typename Key, typename Visitor>
+bool readRecords(BlockReader &in, Visitor visit) {
+    constexpr std::size_t kRecordSize = RecordWriter<Key>::kRecordSize;
+    char carry[sizeof(kMagic) > kRecordSize ? sizeof(kMagic) : kRecordSize];
+    std::size_t carried = 0;
+    bool magicSeen = false;
+
+    auto consume = [&](const char *record) {
+        auto op = static_cast<ChangeOp>(record[0]);
+        if (op != ChangeOp::Insert && op != ChangeOp::Erase) {
+            return false;
+        }
+        Key key;
+        std::memcpy(&key, record + 1, sizeof(Key));
+        visit(op, key);
+        return true;
+    };
+
+    for (auto block = in.next(); !block.empty(); block = in.next()) {
+        const char *p = block.data();
+        const char *end = p + block.size();
+        while (p != end) {
+            std::size_t want = magicSeen ? kRecordSize : sizeof(kMagic);
+            if (carried == 0 && static_cast<std::size_t>(end - p) >= want) {
+                if (!magicSeen) {
+                    if (std::memcmp(p, kMagic, sizeof(kMagic)) != 0) {
+                        return false;
+                    }
+                    magicSeen = true;
+                } else if (!consume(p)) {
+                    return false;
+                }
+                p += want;
+                continue;
+            }
+            std::size_t take = std::min<std::size_t>(want - carried, end - p);
+            std::memcpy(carry + carried, p, take);
+            carried += take;
+            p += take;
+            if (carried == want) {
+                if (!magicSeen) {
+                    if (std::memcmp(carry, kMagic, sizeof(kMagic)) != 0) {
+                        return false;
+                    }
+                    magicSeen = true;
+                } else if (!consume(carry)) {
+                    return false;
+                }
+                carried = 0;
+            }
+        }
+    }
+    return in.ok() && magicSeen && carried == 0;
+}
+
+} // namespace checkpoint_format
+
+/**
+ * @brief Online (fuzzy) checkpoint of a SkipList that keeps writers running.
+ *
+ * A background thread copies the list in chunks of at most @c chunkKeys
+ * keys, holding the writers' mutex only while one chunk is copied, so a
+ * writer is delayed by at most one chunk copy. Because writers continue
+ * between chunks, the copied image is fuzzy; every mutation made while the
+ * checkpoint runs is therefore captured as a write-ahead record through the
+ * list's ChangeSink and written in order between the image chunks. Replaying
+ * the file applies, for every key, its last recorded operation, which
+ * yields exactly the state of the list at the moment capture stopped.
+ *
+ * All writers must mutate the list only while holding the mutex passed to
+ * the constructor. A sink already attached to the list keeps receiving
+ * events during the checkpoint.
+ *
+ * @tparam Key type of key, must be trivially copyable
+ */
+template <typename Key> class Checkpointer {
+    static_assert(std::is_trivially_copyable_v<Key>,
+                  "checkpointed keys are written as raw bytes");
+
+  public:
+    /**
+     * @brief Prepares a checkpoint of @p list into the file @p path.
+     *
+     * @param list       The list to checkpoint
+     * @param writeMutex Mutex every writer of @p list holds while mutating
+     * @param path       Destination file; written as path + ".tmp" and
+     * renamed once complete
+     * @param chunkKeys  Maximum number of keys copied per lock acquisition
+     * @param backend    I/O strategy used to write the file
+     */
+    Checkpointer(SkipList<Key> &list, std::mutex &writeMutex, std::string path,
+                 std::size_t chunkKeys = 4096,
+                 IoBackend backend = IoBackend::Blocking)
+        : list_(list), mutex_(writeMutex), path_(std::move(path)),
+          chunkKeys_(chunkKeys ? chunkKeys : 1), backend_(backend) {}
+
+    ~Checkpointer() {
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    Checkpointer(const Checkpointer &) = delete;
+    Checkpointer &operator=(const Checkpointer &) = delete;
+
+    /**
+     * @brief Starts writing the checkpoint in a background thread.
+     */
+    void start() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            capture_.next = list_.changeSink();
+            list_.setChangeSink(&capture_);
+            capturing_.store(true);
+        }
+        worker_ = std::thread([this] { ok_ = run(); });
+    }
+
+    /**
+     * @brief Waits until the checkpoint is complete.
+     *
+     * @return true if the file was written successfully.
+     */
+    bool wait() {
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+        return ok_;
+    }
+
+    /**
+     * @brief Whether mutations are still being captured.
+     *
+     * Changes only under the writers' mutex, so a writer holding the mutex
+     * that sees false knows its mutation is not part of the checkpoint.
+     */
+    bool capturing() const { return capturing_.load(); }
+
+    std::size_t imageRecords() const { return imageRecords_; }
+    std::size_t logRecords() const { return logRecords_; }
+
+  private:
+    /**
+     * @brief Sink recording the mutations made during the checkpoint.
+     */
+    struct Capture : ChangeSink<Key> {
+        std::vector<ChangeEvent<Key>> log;
+        ChangeSink<Key> *next = nullptr;
+
+        void onInsert(const Key &key) override {
+            log.push_back({0, ChangeOp::Insert, key});
+            if (next) {
+                next->onInsert(key);
+            }
+        }
+        void onErase(const Key &key) override {
+            log.push_back({0, ChangeOp::Erase, key});
+            if (next) {
+                next->onErase(key);
+            }
+        }
+    };
+
+    bool run() {
+        std::string tmpPath = path_ + ".tmp";
+        auto file = makeBlockWriter(tmpPath, backend_);
+        std::optional<checkpoint_format::RecordWriter<Key>> out;
+        if (file) {
+            out.emplace(*file);
+        }
+
+        std::vector<Key> chunk;
+        std::vector<ChangeEvent<Key>> log;
+        Key last{};
+        bool started = false;
+        bool finished = false;
+
+        while (!finished) {
+            chunk.clear();
+            log.clear();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                log.swap(capture_.log);
+
+                auto it = started ? list_.lower_bound(last) : list_.begin();
+                if (started && it != list_.end() && *it == last) {
+                    ++it;
+                }
+                for (; it != list_.end() && chunk.size() < chunkKeys_; ++it) {
+                    chunk.push_back(*it);
+                }
+
+                if (it == list_.end()) {
+                    list_.setChangeSink(capture_.next);
+                    capturing_.store(false);
+                    finished = true;
+                }
+            }
+
+            if (out) {
+                for (const auto &event : log) {
+                    out->write(event.op, event.key);
+                }
+                for (const Key &key : chunk) {
+                    out->write(ChangeOp::Insert, key);
+                }
+            }
+            logRecords_ += log.size();
+            imageRecords_ += chunk.size();
+
+            if (!chunk.empty()) {
+                last = chunk.back();
+                started = true;
+            }
+        }
+
+        if (!out || !out->finish()) {
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+        return std::rename(tmpPath.c_str(), path_.c_str()) == 0;
+    }
+
+    SkipList<Key> &list_;
+    std::mutex &mutex_;
+    std::string path_;
+    std::size_t chunkKeys_;
+    IoBackend backend_;
+
+    Capture capture_; ///< Guarded by mutex_ while attached
+    std::atomic<bool> capturing_{false};
+    std::thread worker_;
+    bool ok_ = false;
+    std::size_t imageRecords_ = 0;
+    std::size_t logRecords_ = 0;
+};
+
+/**
+ * @brief Writes a checkpoint of a list that no thread is modifying.
+ *
+ * Produces the same format as Checkpointer without taking any lock, so a
+ * frozen list can be flushed at full speed.
+ *
+ * @return false if the file could not be written.
+ */
+template <typename Key>
+bool saveCheckpoint(const SkipList<Key> &list, const std::string &path,
+                    IoBackend backend = IoBackend::Blocking) {
+    auto file = makeBlockWriter(path, backend);
+    if (!file) {
+        return false;
+    }
+    checkpoint_format::RecordWriter<Key> out(*file);
+    for (const Key &key : list) {
+        out.write(ChangeOp::Insert, key);
+    }
+    return out.finish();
+}
+
+/**
+ * @brief Loads a checkpoint written by Checkpointer or saveCheckpoint() into
+ * @p list.
+ *
+ * The records are replayed in batches through ChangeStream::applyEvents(),
+ * so the sorted image is inserted with SkipList::insertSorted().
+ *
+ * @return false if the file cannot be read or is malformed.
+ */
+template <typename Key>
+bool loadCheckpoint(const std::string &path, SkipList<Key> &list,
+                    IoBackend backend = IoBackend::Blocking) {
+    static_assert(std::is_trivially_copyable_v<Key>,
+                  "checkpointed keys are read as raw bytes");
+
+    auto file = makeBlockReader(path, backend);
+    if (!file) {
+        return false;
+    }
+
+    constexpr std::size_t kBatch = 4096;
+    std::vector<ChangeEvent<Key>> batch;
+    std::vector<Key> scratch;
+    auto flush = [&] {
+        ChangeStream<Key>::applyEvents(batch.begin(), batch.end(), list,
+                                       scratch);
+        batch.clear();
+    };
+
+    bool ok = checkpoint_format::readRecords<Key>(
+        *file, [&](ChangeOp op, const Key &key) {
+            batch.push_back({0, op, key});
+            if (batch.size() == kBatch) {
+                flush();
+            }
+        });
+    flush();
+    return ok;
+}
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,548 @@
+#ifndef CONCURRENT_SKIP_LIST_HPP
+#define CONCURRENT_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Concurrent set whose writers only touch the bottom level.
+ *
+ * Keys live in a lock-free sorted linked list: insert() links a node with
+ * one CAS on its predecessor, erase() marks the node with one CAS on its
+ * own link, and every operation unlinks the marked nodes it walks over.
+ * There are no towers to update, so concurrent writers never meet on the
+ * upper-level predecessors near the head.
+ *
+ * The upper levels are an immutable index, rebuilt by a background thread
+ * from the live nodes and published with a single pointer swap; operations
+ * use it to find where to start walking the bottom list. Node heights are
+ * derived from the key hash as in LevelMode::Hashed, so a rebuild yields
+ * the same towers for the keys that did not change. The index is only
+ * rebuilt once a fraction of the keys changed since the last one; until
+ * then new keys are reached by walking a little further at the bottom.
+ *
+ * Unlinked nodes and replaced indexes are freed by the maintenance thread
+ * once every operation that could still see them has left (epoch based
+ * reclamation over striped reader counters). Nodes of height 1 are never
+ * in the index, so they are freed after that grace period alone; taller
+ * ones may still be referenced by the index and wait for the next
+ * rebuild.
+ *
+ * @tparam Key type of key, must be LessThanComparable, copyable, default
+ * constructible and hashable with std::hash
+ */
+template <typename Key> class ConcurrentSkipList {
+  public:
+    /**
+     * @brief Constructs an empty set and starts its maintenance thread.
+     *
+     * @param probability     Probability p of promoting a key to the next
+     * index level
+     * @param maxAllowedLevel Maximum height of a tower, bottom level included
+     * @param interval        How often the maintenance thread checks whether
+     * the index needs a rebuild
+     */
+    explicit ConcurrentSkipList(
+        double probability = 0.5, int maxAllowedLevel = 32,
+        std::chrono::milliseconds interval = std::chrono::milliseconds(1))
+        : head_(new Node(Key(), 1)), index_(new Index),
+          probability_(probability), maxAllowedLevel_(maxAllowedLevel),
+          interval_(interval), worker_([this] { run(); }) {}
+
+    ~ConcurrentSkipList() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        worker_.join();
+
+        freeChain(retired_.load());
+        freeChain(parked_);
+        Node *cur = head_;
+        while (cur) {
+            Node *next = pointer(cur->next.load());
+            delete cur;
+            cur = next;
+        }
+        delete index_.load();
+    }
+
+    ConcurrentSkipList(const ConcurrentSkipList &) = delete;
+    ConcurrentSkipList &operator=(const ConcurrentSkipList &) = delete;
+
+    /**
+     * @brief Inserts a key.
+     *
+     * @return false if the key was already present.
+     */
+    bool insert(const Key &key) {
+        Guard guard(*this);
+        Node *node = nullptr;
+        for (;;) {
+            auto [pred, cur] = findFrom(startFor(key), key);
+            if (cur && !(key < cur->key)) {
+                delete node;
+                return false;
+            }
+            if (!node) {
+                node = new Node(key, heightOf(key));
+            }
+            node->next.store(link(cur), std::memory_order_relaxed);
+            std::uintptr_t expected = link(cur);
+            if (pred->next.compare_exchange_strong(expected, link(node),
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Removes a key.
+     *
+     * @return false if the key was not present.
+     */
+    bool erase(const Key &key) {
+        Guard guard(*this);
+        auto [pred, cur] = findFrom(startFor(key), key);
+        if (!cur || key < cur->key) {
+            return false;
+        }
+        std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+        do {
+            if (next & kMarked) {
+                return false; // Erased concurrently
+            }
+        } while (!cur->next.compare_exchange_weak(next, next | kMarked,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire));
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        pending_.fetch_add(1, std::memory_order_relaxed);
+
+        // Unlink it now if nothing changed around it, else leave it to the
+        // next operation walking by
+        if (unlink(pred, cur, next)) {
+            retire(cur);
+        }
+        return true;
+    }
+
+    bool contains(const Key &key) const {
+        Guard guard(*this);
+        Node *cur = startFor(key);
+        while (cur && (cur == head_ || cur->key < key)) {
+            cur = pointer(cur->next.load(std::memory_order_acquire));
+        }
+        return cur && !(key < cur->key) &&
+               !(cur->next.load(std::memory_order_acquire) & kMarked);
+    }
+
+    /**
+     * @brief Calls visit(const Key &) on the keys in ascending order.
+     *
+     * Keys inserted or erased during the walk may or may not be visited.
+     */
+    template <typename Visitor> void forEach(Visitor visit) const {
+        Guard guard(*this);
+        Node *cur = pointer(head_->next.load(std::memory_order_acquire));
+        while (cur) {
+            std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+            if (!(next & kMarked)) {
+                visit(cur->key);
+            }
+            cur = pointer(next);
+        }
+    }
+
+    /**
+     * @brief Number of keys (exact when no operation is running).
+     */
+    std::size_t size() const {
+        std::int64_t n = size_.load(std::memory_order_relaxed);
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * @brief Rebuilds the index and frees the retired nodes now, instead of
+     * waiting for the maintenance thread.
+     */
+    void rebuildIndex() {
+        std::lock_guard<std::mutex> lock(maintainMutex_);
+        maintain();
+    }
+
+    /**
+     * @brief Number of levels of the current index above the bottom list.
+     */
+    std::size_t indexLevels() const {
+        Guard guard(*this);
+        return index_.load(std::memory_order_acquire)->levels.size();
+    }
+
+    /**
+     * @brief Number of index rebuilds made so far.
+     */
+    std::size_t rebuilds() const {
+        return rebuilds_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of erased nodes freed so far.
+     */
+    std::size_t freedNodes() const {
+        return freed_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr std::uintptr_t kMarked = 1; ///< Node is erased
+    static constexpr std::size_t kStripes = 16;
+    static constexpr std::size_t kCacheLine = 64;
+
+    struct Node {
+        const Key key;
+        std::atomic<std::uintptr_t> next{0}; ///< Successor | kMarked
+        const int height;                    ///< Tower height in the index
+        Node *retiredNext = nullptr;         ///< Links the retired nodes
+
+        Node(const Key &k, int h) : key(k), height(h) {}
+    };
+
+    /**
+     * @brief Immutable upper levels: levels[0] holds the nodes at least 2
+     * high, levels[1] those at least 3 high, and so on.
+     */
+    struct Index {
+        struct Entry {
+            Key key;
+            Node *node;
+            std::uint32_t down; ///< Position of the node one level lower
+        };
+        std::vector<std::vector<Entry>> levels;
+    };
+
+    /**
+     * @brief Readers of one epoch parity, spread over cache lines so that
+     * threads entering and leaving do not share a counter.
+     */
+    struct alignas(kCacheLine) Stripe {
+        std::array<std::atomic<std::uint64_t>, 2> active{};
+    };
+
+    /**
+     * @brief Keeps the nodes and index seen by an operation alive.
+     */
+    class Guard {
+      public:
+        explicit Guard(const ConcurrentSkipList &list)
+            : stripe_(list.stripes_[stripeIndex()]) {
+            for (;;) {
+                std::uint64_t epoch = list.epoch_.load();
+                parity_ = epoch & 1;
+                stripe_.active[parity_].fetch_add(1);
+                if (list.epoch_.load() == epoch) {
+                    return;
+                }
+                stripe_.active[parity_].fetch_sub(1);
+            }
+        }
+        ~Guard() { stripe_.active[parity_].fetch_sub(1); }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+      private:
+        static std::size_t stripeIndex() {
+            static std::atomic<std::size_t> threads{0};
+            thread_local std::size_t index = threads.fetch_add(1) % kStripes;
+            return index;
+        }
+
+        Stripe &stripe_;
+        std::size_t parity_ = 0;
+    };
+
+    static Node *pointer(std::uintptr_t link) {
+        return reinterpret_cast<Node *>(link & ~kMarked);
+    }
+    static std::uintptr_t link(Node *node) {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+
+    int heightOf(const Key &key) const {
+        using skip_list_detail::splitmix64;
+        using skip_list_detail::toUnit;
+        std::uint64_t x = std::hash<Key>{}(key);
+        int height = 1;
+        while (height < maxAllowedLevel_ &&
+               toUnit(splitmix64(x)) < probability_) {
+            ++height;
+        }
+        return height;
+    }
+
+    /**
+     * @brief Last indexed node before @p key, or the head.
+     */
+    Node *startFor(const Key &key) const {
+        const Index *index = index_.load(std::memory_order_acquire);
+        std::int64_t pos = -1;
+        for (std::size_t l = index->levels.size(); l-- > 0;) {
+            const auto &level = index->levels[l];
+            while (pos + 1 < static_cast<std::int64_t>(level.size()) &&
+                   level[pos + 1].key < key) {
+                ++pos;
+            }
+            if (l > 0 && pos >= 0) {
+                pos = level[pos].down;
+            }
+        }
+        if (pos < 0) {
+            return head_;
+        }
+        Node *node = index->levels[0][pos].node;
+        // An erased start may already be unlinked: its successors are not
+        // necessarily in the list any more
+        if (node->next.load(std::memory_order_acquire) & kMarked) {
+            return head_;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Walks from @p start to the first node not less than @p key,
+     * unlinking the marked nodes met on the way.
+     *
+     * @return The last unmarked node before @p key and the node after it.
+     */
+    std::pair<Node *, Node *> findFrom(Node *start, const Key &key) {
+        for (;;) {
+            Node *pred = start;
+            std::uintptr_t first = pred->next.load(std::memory_order_acquire);
+            if (first & kMarked) {
+                start = head_; // The head is never marked
+                continue;
+            }
+            Node *cur = pointer(first);
+            bool raced = false;
+            while (cur) {
+                std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+                if (next & kMarked) {
+                    if (!unlink(pred, cur, next)) {
+                        raced = true;
+                        break;
+                    }
+                    retire(cur);
+                    cur = pointer(next);
+                    continue;
+                }
+                if (!(cur->key < key)) {
+                    break;
+                }
+                pred = cur;
+                cur = pointer(next);
+            }
+            if (!raced) {
+                return {pred, cur};
+            }
+        }
+    }
+
+    /**
+     * @brief Replaces the link from @p pred to the marked @p node by its
+     * successor.
+     *
+     * @return false if @p pred no longer links to @p node or was marked.
+     */
+    static bool unlink(Node *pred, Node *node, std::uintptr_t next) {
+        std::uintptr_t expected = link(node);
+        return pred->next.compare_exchange_strong(expected, next & ~kMarked,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Hands an unlinked node to the maintenance thread.
+     */
+    void retire(Node *node) {
+        Node *top = retired_.load(std::memory_order_relaxed);
+        do {
+            node->retiredNext = top;
+        } while (!retired_.compare_exchange_weak(top, node,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Frees a chain of retired nodes.
+     *
+     * @return Number of nodes freed.
+     */
+    static std::size_t freeChain(Node *node) {
+        std::size_t count = 0;
+        for (; node; ++count) {
+            Node *next = node->retiredNext;
+            delete node;
+            node = next;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Frees the retired nodes the index cannot reference, without a
+     * rebuild, and parks the others until the next one. Called with
+     * maintainMutex_ held.
+     */
+    void reclaim() {
+        Node *unlinked = retired_.exchange(nullptr, std::memory_order_acquire);
+        Node *unindexed = nullptr;
+        while (unlinked) {
+            Node *next = unlinked->retiredNext;
+            Node *&chain = unlinked->height > 1 ? parked_ : unindexed;
+            unlinked->retiredNext = chain;
+            chain = unlinked;
+            unlinked = next;
+        }
+        if (unindexed) {
+            synchronize();
+            freed_.fetch_add(freeChain(unindexed), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Whether enough keys changed since the last rebuild. Called
+     * with maintainMutex_ held.
+     */
+    bool needsRebuild() const {
+        std::uint64_t pending = pending_.load(std::memory_order_relaxed);
+        return pending > 0 && pending * 8 >= indexed_;
+    }
+
+    /**
+     * @brief Unlinks the marked nodes, publishes a new index and frees what
+     * no operation can reach any more. Called with maintainMutex_ held.
+     */
+    void maintain() {
+        // Only nodes unlinked before the walk below are sure to be left out
+        // of the new index
+        Node *unlinked = retired_.exchange(nullptr, std::memory_order_acquire);
+        pending_.store(0, std::memory_order_relaxed);
+        Node *parked = std::exchange(parked_, nullptr);
+
+        auto *index = new Index;
+        std::size_t live = 0;
+        Node *pred = head_;
+        Node *cur = pointer(pred->next.load(std::memory_order_acquire));
+        while (cur) {
+            std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+            if (next & kMarked) {
+                if (unlink(pred, cur, next)) {
+                    cur->retiredNext = unlinked;
+                    unlinked = cur;
+                } else {
+                    pred = cur; // Left for a later pass
+                }
+                cur = pointer(next);
+                continue;
+            }
+            addToIndex(*index, cur);
+            ++live;
+            pred = cur;
+            cur = pointer(next);
+        }
+
+        Index *old = index_.exchange(index, std::memory_order_acq_rel);
+        indexed_ = live;
+        rebuilds_.fetch_add(1, std::memory_order_relaxed);
+
+        synchronize();
+        freed_.fetch_add(freeChain(unlinked) + freeChain(parked),
+                         std::memory_order_relaxed);
+        delete old;
+    }
+
+    static void addToIndex(Index &index, Node *node) {
+        std::uint32_t down = 0;
+        for (int l = 0; l + 1 < node->height; ++l) {
+            if (index.levels.size() == static_cast<std::size_t>(l)) {
+                index.levels.emplace_back();
+            }
+            auto &level = index.levels[l];
+            auto here = static_cast<std::uint32_t>(level.size());
+            level.push_back({node->key, node, down});
+            down = here;
+        }
+    }
+
+    /**
+     * @brief Waits until every operation started before the call has left.
+     */
+    void synchronize() {
+        std::uint64_t epoch = epoch_.fetch_add(1);
+        for (const Stripe &stripe : stripes_) {
+            while (stripe.active[epoch & 1].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_) {
+            wake_.wait_for(lock, interval_);
+            if (stop_) {
+                return;
+            }
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> guard(maintainMutex_);
+                if (needsRebuild()) {
+                    maintain();
+                } else if (retired_.load(std::memory_order_relaxed)) {
+                    reclaim();
+                }
+            }
+            lock.lock();
+        }
+    }
+
+    Node *const head_;
+    std::atomic<Index *> index_;
+    std::atomic<Node *> retired_{nullptr}; ///< Unlinked, not yet freed
+    Node *parked_ = nullptr; ///< Retired indexed nodes, see reclaim()
+    alignas(kCacheLine) std::atomic<std::int64_t> size_{0};
+    alignas(kCacheLine) std::atomic<std::uint64_t> pending_{0};
+
+    mutable std::array<Stripe, kStripes> stripes_;
+    std::atomic<std::uint64_t> epoch_{0};
+
+    double probability_;
+    int maxAllowedLevel_;
+    std::size_t indexed_ = 0; ///< Live keys at the last rebuild
+    std::atomic<std::size_t> rebuilds_{0};
+    std::atomic<std::size_t> freed_{0};
+
+    std::chrono::milliseconds interval_;
+    std::mutex maintainMutex_; ///< Serializes maintain()
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::thread worker_;
+};
+
+#endif // CONCURRENT_SKIP_LIST_HPP
@@ -0,0 +1,273 @@
+#ifndef INTRUSIVE_SKIP_LIST_HPP
+#define INTRUSIVE_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Tower embedded in an object linked into an IntrusiveSkipList.
+ *
+ * An object needs one hook per list it can be linked into at the same time.
+ *
+ * @tparam T        type of the object holding the hook
+ * @tparam MaxLevel maximum height of the tower (at most 255)
+ */
+template <typename T, int MaxLevel = 16> struct SkipListHook {
+    static_assert(MaxLevel > 0 && MaxLevel < 256, "unsupported tower height");
+    static constexpr int kMaxLevel = MaxLevel;
+
+    std::array<T *, MaxLevel> next{}; ///< Only the first `level` are used
+    std::uint8_t level = 0;           ///< 0 while not linked
+
+    bool linked() const { return level != 0; }
+};
+
+/**
+ * @brief Skip list over caller-owned objects.
+ *
+ * The object embeds the tower (a SkipListHook member named by @p Hook) and
+ * provides its key through @p KeyOf, so linking an object allocates nothing
+ * and copies no key: the list only rewires the pointers of the hooks. The
+ * head is an array inside the list and the search path is kept on the
+ * stack.
+ *
+ * The caller keeps each object alive and its key unchanged while it is
+ * linked, and must unlink it before destroying it. Destroying the list
+ * unlinks every object.
+ *
+ * @tparam T     type of the linked objects
+ * @tparam Hook  pointer to the SkipListHook<T, L> member used by this list
+ * @tparam KeyOf function object returning the key of a const T &; keys must
+ * be unique and LessThanComparable
+ */
+template <typename T, auto Hook, typename KeyOf> class IntrusiveSkipList {
+    using HookType = std::remove_reference_t<decltype(std::declval<T &>().*
+                                                      Hook)>;
+    static constexpr int kMaxLevel = HookType::kMaxLevel;
+
+  public:
+    using Key = std::remove_cvref_t<std::invoke_result_t<KeyOf, const T &>>;
+
+    /**
+     * @brief Forward iterator over the linked objects in key order.
+     */
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        Iterator() = default;
+        explicit Iterator(T *obj) : obj_(obj) {}
+
+        reference operator*() const { return *obj_; }
+        pointer operator->() const { return obj_; }
+
+        Iterator &operator++() {
+            obj_ = (obj_->*Hook).next[0];
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return obj_ == other.obj_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return obj_ != other.obj_;
+        }
+
+      private:
+        T *obj_ = nullptr;
+    };
+
+    /**
+     * @brief Constructs an empty list.
+     *
+     * @param probability Probability p of promoting a node to the next level
+     */
+    explicit IntrusiveSkipList(double probability = 0.5)
+        : probability_(probability),
+          rngState_(skip_list_detail::nextSeed()) {}
+
+    ~IntrusiveSkipList() { clear(); }
+
+    IntrusiveSkipList(const IntrusiveSkipList &) = delete;
+    IntrusiveSkipList &operator=(const IntrusiveSkipList &) = delete;
+
+    /**
+     * @brief Links @p obj into the list.
+     *
+     * @p obj must not be linked through this hook already.
+     *
+     * @return false if an object with the same key is linked (then @p obj
+     * stays unlinked).
+     */
+    bool insert(T &obj) {
+        HookType &hook = obj.*Hook;
+        assert(!hook.linked());
+        const Key &key = KeyOf{}(obj);
+
+        std::array<HookType *, kMaxLevel> update;
+        T *next = findPreds(key, update);
+        if (next && !(key < KeyOf{}(*next))) {
+            return false;
+        }
+
+        int level = randomLevel();
+        for (int i = maxLevel_; i < level; ++i) {
+            update[i] = &head_;
+        }
+        maxLevel_ = std::max(maxLevel_, level);
+
+        hook.level = static_cast<std::uint8_t>(level);
+        for (int i = 0; i < level; ++i) {
+            hook.next[i] = update[i]->next[i];
+            update[i]->next[i] = &obj;
+        }
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Unlinks @p obj from the list.
+     *
+     * @return false if @p obj is not linked into this list.
+     */
+    bool erase(T &obj) {
+        if (!(obj.*Hook).linked()) {
+            return false;
+        }
+        std::array<HookType *, kMaxLevel> update;
+        if (findPreds(KeyOf{}(obj), update) != &obj) {
+            return false;
+        }
+        unlink(obj, update);
+        return true;
+    }
+
+    /**
+     * @brief Unlinks the object with key @p key.
+     *
+     * @return The unlinked object, or nullptr if no object has this key.
+     */
+    T *erase(const Key &key) {
+        std::array<HookType *, kMaxLevel> update;
+        T *obj = findPreds(key, update);
+        if (!obj || key < KeyOf{}(*obj)) {
+            return nullptr;
+        }
+        unlink(*obj, update);
+        return obj;
+    }
+
+    /**
+     * @brief Finds the object with key @p key, or nullptr.
+     */
+    T *find(const Key &key) const {
+        T *obj = lowerBound(key);
+        return obj && !(key < KeyOf{}(*obj)) ? obj : nullptr;
+    }
+
+    bool contains(const Key &key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Returns an iterator to the first object whose key is not less
+     * than @p key.
+     */
+    Iterator lower_bound(const Key &key) const {
+        return Iterator(lowerBound(key));
+    }
+
+    /**
+     * @brief Unlinks every object, leaving their hooks ready for reuse.
+     */
+    void clear() {
+        T *obj = head_.next[0];
+        while (obj) {
+            HookType &hook = obj->*Hook;
+            T *next = hook.next[0];
+            hook = HookType{};
+            obj = next;
+        }
+        head_ = HookType{};
+        maxLevel_ = 1;
+        size_ = 0;
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    Iterator begin() const { return Iterator(head_.next[0]); }
+    Iterator end() const { return Iterator(nullptr); }
+
+  private:
+    /**
+     * @brief Fills @p update with the hooks preceding @p key at every level.
+     *
+     * @return The first object whose key is not less than @p key.
+     */
+    T *findPreds(const Key &key, std::array<HookType *, kMaxLevel> &update) {
+        HookType *pred = &head_;
+        for (int i = maxLevel_ - 1; i >= 0; --i) {
+            while (pred->next[i] && KeyOf{}(*pred->next[i]) < key) {
+                pred = &(pred->next[i]->*Hook);
+            }
+            update[i] = pred;
+        }
+        return pred->next[0];
+    }
+
+    T *lowerBound(const Key &key) const {
+        const HookType *pred = &head_;
+        for (int i = maxLevel_ - 1; i >= 0; --i) {
+            while (pred->next[i] && KeyOf{}(*pred->next[i]) < key) {
+                pred = &(pred->next[i]->*Hook);
+            }
+        }
+        return pred->next[0];
+    }
+
+    void unlink(T &obj, const std::array<HookType *, kMaxLevel> &update) {
+        HookType &hook = obj.*Hook;
+        for (int i = 0; i < hook.level; ++i) {
+            update[i]->next[i] = hook.next[i];
+        }
+        hook = HookType{};
+        --size_;
+        while (maxLevel_ > 1 && head_.next[maxLevel_ - 1] == nullptr) {
+            --maxLevel_;
+        }
+    }
+
+    int randomLevel() {
+        int level = 1;
+        while (level < kMaxLevel && level < maxLevel_ + 1 &&
+               skip_list_detail::toUnit(
+                   skip_list_detail::splitmix64(rngState_)) < probability_) {
+            ++level;
+        }
+        return level;
+    }
+
+    HookType head_; ///< Forward pointers of the head
+    int maxLevel_ = 1;
+    std::size_t size_ = 0;
+    double probability_;
+    std::uint64_t rngState_;
+};
+
+#endif // INTRUSIVE_SKIP_LIST_HPP
@@ -0,0 +1,88 @@
+#ifndef KEY_FILTER_HPP
+#define KEY_FILTER_HPP
+
+#include <bit>
+#include <limits>
+#include <type_traits>
+
+/**
+ * @brief Predicate on integer keys for the filtered scans (scanIf()).
+ *
+ * A key matches if it lies in [lo, hi], its bits selected by a mask equal
+ * a value, and it has a given remainder modulo some number. The conditions
+ * are combined without branches, so evaluating the filter over a batch of
+ * keys is a straight loop the compiler can vectorize. Building it
+ * "compiles" the conditions: a power-of-two modulus becomes a bit mask, so
+ * only other moduli keep a division.
+ *
+ * @code
+ * auto filter = KeyFilter<std::uint64_t>().range(100, 900).modulo(8, 3);
+ * list.scanIf(0, 1000, filter, [](std::uint64_t key) { ... });
+ * @endcode
+ *
+ * @tparam Key unsigned or signed integer key type
+ */
+template <typename Key> class KeyFilter {
+    static_assert(std::is_integral_v<Key>, "KeyFilter needs integer keys");
+    using Bits = std::make_unsigned_t<Key>;
+
+  public:
+    /**
+     * @brief Keeps the keys in [lo, hi], both inclusive.
+     */
+    KeyFilter &range(Key lo, Key hi) {
+        lo_ = lo;
+        hi_ = hi;
+        return *this;
+    }
+
+    /**
+     * @brief Keeps the keys whose bits under @p mask equal @p value; adds
+     * to the bit conditions set before.
+     */
+    KeyFilter &bits(Bits mask, Bits value) {
+        // Bits required both ways can never match: keep them unsatisfiable
+        Bits conflict = mask_ & mask & (value_ ^ value);
+        mask_ |= mask;
+        value_ = (value_ & ~mask) | (value & mask);
+        never_ = never_ || conflict != 0;
+        return *this;
+    }
+
+    /**
+     * @brief Keeps the keys equal to @p remainder modulo @p modulus; a
+     * modulus of 0 adds no condition.
+     */
+    KeyFilter &modulo(Bits modulus, Bits remainder) {
+        if (modulus == 0) {
+            return *this;
+        }
+        if (std::has_single_bit(modulus)) {
+            return bits(modulus - 1, remainder & (modulus - 1));
+        }
+        modulus_ = modulus;
+        remainder_ = remainder % modulus;
+        return *this;
+    }
+
+    bool operator()(Key key) const {
+        Bits b = static_cast<Bits>(key);
+        bool match = (key >= lo_) & (key <= hi_) & ((b & mask_) == value_) &
+                     !never_;
+        if (modulus_ > 1) {
+            match &= b % modulus_ == remainder_;
+        }
+        return match;
+    }
+
+  private:
+    Key lo_ = std::numeric_limits<Key>::min();
+    Key hi_ = std::numeric_limits<Key>::max();
+    Bits mask_ = 0;
+    Bits value_ = 0;
+    Bits modulus_ = 1; ///< 1 when there is no modulo condition
+    Bits remainder_ = 0;
+    bool never_ = false;
+};
+
+#endif // KEY_FILTER_HPP
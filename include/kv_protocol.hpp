@@ -0,0 +1,102 @@
+#ifndef KV_PROTOCOL_HPP
+#define KV_PROTOCOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief Binary protocol of the skip list key/value server.
+ *
+ * Clients talk to the server over a Unix domain socket, so both ends share
+ * the host byte order and frames are plain fixed‑size records:
+ *
+ * - request  (24 bytes): op (1 byte), 7 padding bytes, key (8), value (8)
+ * - response (16 bytes): status (1 byte), 7 padding bytes, value (8)
+ *
+ * A client may pipeline any number of requests without waiting; the server
+ * answers them strictly in order, batching the responses of everything it
+ * read in one go into a single write.
+ */
+namespace kv {
+
+enum class Op : std::uint8_t {
+    Get = 1, ///< Look up a key, the response carries its value
+    Put = 2, ///< Insert or overwrite a key
+    Del = 3, ///< Remove a key
+};
+
+enum class Status : std::uint8_t {
+    Ok = 0,
+    NotFound = 1,
+    BadRequest = 2,
+};
+
+struct Request {
+    Op op;
+    std::uint64_t key;
+    std::uint64_t value;
+};
+
+struct Response {
+    Status status;
+    std::uint64_t value;
+};
+
+inline constexpr std::size_t kRequestSize = 24;
+inline constexpr std::size_t kResponseSize = 16;
+
+inline void encode(const Request &req, unsigned char *out) {
+    std::memset(out, 0, kRequestSize);
+    out[0] = static_cast<unsigned char>(req.op);
+    std::memcpy(out + 8, &req.key, sizeof(req.key));
+    std::memcpy(out + 16, &req.value, sizeof(req.value));
+}
+
+inline Request decodeRequest(const unsigned char *in) {
+    Request req;
+    req.op = static_cast<Op>(in[0]);
+    std::memcpy(&req.key, in + 8, sizeof(req.key));
+    std::memcpy(&req.value, in + 16, sizeof(req.value));
+    return req;
+}
+
+inline void encode(const Response &resp, unsigned char *out) {
+    std::memset(out, 0, kResponseSize);
+    out[0] = static_cast<unsigned char>(resp.status);
+    std::memcpy(out + 8, &resp.value, sizeof(resp.value));
+}
+
+inline Response decodeResponse(const unsigned char *in) {
+    Response resp;
+    resp.status = static_cast<Status>(in[0]);
+    std::memcpy(&resp.value, in + 8, sizeof(resp.value));
+    return resp;
+}
+
+/**
+ * @brief Executes one request against an ordered map such as
+ * SkipListMap<std::uint64_t, std::uint64_t>; an unknown op yields
+ * Status::BadRequest and leaves the map unchanged.
+ */
+template <typename Map> Response execute(Map &map, const Request &req) {
+    switch (req.op) {
+    case Op::Get: {
+        auto it = map.find(req.key);
+        if (it == map.end()) {
+            return {Status::NotFound, 0};
+        }
+        return {Status::Ok, it->value};
+    }
+    case Op::Put:
+        map.insertOrAssign(req.key, req.value);
+        return {Status::Ok, 0};
+    case Op::Del:
+        return {map.erase(req.key) ? Status::Ok : Status::NotFound, 0};
+    }
+    return {Status::BadRequest, 0};
+}
+
+} // namespace kv
+
+#endif // KV_PROTOCOL_HPP
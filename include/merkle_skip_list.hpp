@@ -0,0 +1,386 @@
+#ifndef MERKLE_SKIP_LIST_HPP
+#define MERKLE_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Skip list whose links carry a digest of the keys they span, for
+ * comparing and syncing replicas.
+ *
+ * Every forward link at every level stores the sum (mod 2^64) of the hashes
+ * of the keys from its source node up to, but excluding, its target; the
+ * links of the head start after the head. Node heights are derived from
+ * the key hash as in LevelMode::Hashed, so two lists holding the same keys
+ * have the same layout and the same link digests. diff() walks both lists
+ * from the top level, skips every segment whose boundaries and digest
+ * agree, and descends only into segments that differ, which finds d
+ * differing keys in expected O(d log n).
+ *
+ * Digests detect accidental divergence, they are not cryptographic.
+ *
+ * @tparam Key type of key, must be LessThanComparable, default
+ * constructible and hashable with std::hash
+ */
+template <typename Key> class MerkleSkipList {
+  private:
+    struct Node;
+
+    struct Link {
+        Node *node = nullptr;
+        std::uint64_t span = 0; ///< Digest of the keys in [source, node)
+    };
+
+    struct Node {
+        const Key key;
+        const std::uint64_t hash; ///< Key hash, 0 for the head
+        std::vector<Link> next;
+
+        Node(const Key &k, std::uint64_t h, int level)
+            : key(k), hash(h), next(level) {}
+    };
+
+  public:
+    /**
+     * @brief Forward iterator over the keys in ascending order.
+     */
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key *;
+        using reference = const Key &;
+
+        Iterator() = default;
+        explicit Iterator(Node *node) : node_(node) {}
+
+        reference operator*() const { return node_->key; }
+        pointer operator->() const { return &node_->key; }
+
+        Iterator &operator++() {
+            node_ = node_->next[0].node;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return node_ == other.node_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return node_ != other.node_;
+        }
+
+      private:
+        Node *node_ = nullptr;
+    };
+
+    /**
+     * @brief Constructs an empty list.
+     *
+     * Replicas can only be compared if they use the same @p probability and
+     * @p maxAllowedLevel.
+     */
+    explicit MerkleSkipList(double probability = 0.5,
+                            int maxAllowedLevel = 32)
+        : head_(new Node(Key(), 0, 1)), maxAllowedLevel_(maxAllowedLevel),
+          probability_(probability) {}
+
+    ~MerkleSkipList() {
+        Node *cur = head_;
+        while (cur) {
+            Node *next = cur->next[0].node;
+            delete cur;
+            cur = next;
+        }
+    }
+
+    MerkleSkipList(const MerkleSkipList &) = delete;
+    MerkleSkipList &operator=(const MerkleSkipList &) = delete;
+
+    /**
+     * @brief Inserts a key, updating the digests of the links spanning it.
+     *
+     * @return false if the key was already present.
+     */
+    bool insert(const Key &key) {
+        Node *found = findPreds(key);
+        if (found && !(key < found->key)) {
+            return false;
+        }
+
+        const std::uint64_t h = keyHash(key);
+        const int level = levelFor(h);
+        if (level > maxLevel_) {
+            head_->next.resize(level, Link{nullptr, total_});
+            update_.resize(level, head_);
+            rank_.resize(level, 0);
+            maxLevel_ = level;
+        }
+
+        Node *node = new Node(key, h, level);
+        // Digest of all keys before the new node
+        const std::uint64_t before = rank_[0] + update_[0]->hash;
+        for (int i = 0; i < level; ++i) {
+            Link &link = update_[i]->next[i];
+            const std::uint64_t left = before - rank_[i];
+            node->next[i] = {link.node, link.span - left + h};
+            link = {node, left};
+        }
+        for (int i = level; i < maxLevel_; ++i) {
+            update_[i]->next[i].span += h;
+        }
+        total_ += h;
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Removes a key, merging the digests of the links around it.
+     *
+     * @return false if the key was not present.
+     */
+    bool erase(const Key &key) {
+        Node *node = findPreds(key);
+        if (!node || key < node->key) {
+            return false;
+        }
+
+        const int level = static_cast<int>(node->next.size());
+        for (int i = 0; i < level; ++i) {
+            Link &link = update_[i]->next[i];
+            link.span += node->next[i].span - node->hash;
+            link.node = node->next[i].node;
+        }
+        for (int i = level; i < maxLevel_; ++i) {
+            update_[i]->next[i].span -= node->hash;
+        }
+        total_ -= node->hash;
+        --size_;
+        delete node;
+
+        while (maxLevel_ > 1 && head_->next[maxLevel_ - 1].node == nullptr) {
+            --maxLevel_;
+            head_->next.pop_back();
+        }
+        return true;
+    }
+
+    bool contains(const Key &key) const {
+        Node *cur = head_;
+        for (int i = maxLevel_ - 1; i >= 0; --i) {
+            while (cur->next[i].node && cur->next[i].node->key < key) {
+                cur = cur->next[i].node;
+            }
+        }
+        cur = cur->next[0].node;
+        return cur && !(key < cur->key);
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Digest of the whole key set.
+     */
+    std::uint64_t digest() const { return total_; }
+
+    Iterator begin() const { return Iterator(head_->next[0].node); }
+    Iterator end() const { return Iterator(nullptr); }
+
+    /**
+     * @brief Reports every key present in exactly one of the two lists.
+     *
+     * Keys are reported in ascending order as visit(const Key &, bool),
+     * where the flag tells whether the key is in this list.
+     *
+     * @return Number of differing keys.
+     */
+    template <typename Visitor>
+    std::size_t diff(const MerkleSkipList &other, Visitor visit) const {
+        assert(probability_ == other.probability_ &&
+               maxAllowedLevel_ == other.maxAllowedLevel_);
+        if (total_ == other.total_ && size_ == other.size_) {
+            return 0;
+        }
+        const int top = std::max(maxLevel_, other.maxLevel_) - 1;
+        return diffRange(other, head_, other.head_, nullptr, nullptr, top,
+                         visit);
+    }
+
+    /**
+     * @brief Makes this list hold the same keys as @p source, touching only
+     * the keys that differ.
+     *
+     * @return Number of keys inserted or erased.
+     */
+    std::size_t syncFrom(const MerkleSkipList &source) {
+        std::vector<Key> missing;
+        std::vector<Key> extra;
+        diff(source, [&](const Key &key, bool inThis) {
+            (inThis ? extra : missing).push_back(key);
+        });
+        for (const Key &key : extra) {
+            erase(key);
+        }
+        for (const Key &key : missing) {
+            insert(key);
+        }
+        return missing.size() + extra.size();
+    }
+
+  private:
+    static std::uint64_t keyHash(const Key &key) {
+        std::uint64_t x = std::hash<Key>{}(key);
+        return skip_list_detail::splitmix64(x);
+    }
+
+    int levelFor(std::uint64_t hash) const {
+        int level = 1;
+        while (level < maxAllowedLevel_ &&
+               skip_list_detail::toUnit(skip_list_detail::splitmix64(hash)) <
+                   probability_) {
+            ++level;
+        }
+        return level;
+    }
+
+    /**
+     * @brief Fills update_ with the predecessors of @p key and rank_ with the
+     * digest of the keys before each of them.
+     *
+     * @return The first node not less than @p key, or nullptr.
+     */
+    Node *findPreds(const Key &key) {
+        update_.assign(maxLevel_, nullptr);
+        rank_.assign(maxLevel_, 0);
+        Node *cur = head_;
+        std::uint64_t before = 0;
+        for (int i = maxLevel_ - 1; i >= 0; --i) {
+            while (cur->next[i].node && cur->next[i].node->key < key) {
+                before += cur->next[i].span;
+                cur = cur->next[i].node;
+            }
+            update_[i] = cur;
+            rank_[i] = before;
+        }
+        return cur->next[0].node;
+    }
+
+    /**
+     * @brief Link of @p node at @p level; levels above the head of a lower
+     * list read as one link spanning every key.
+     */
+    Link linkAt(const Node *node, int level) const {
+        if (level < static_cast<int>(node->next.size())) {
+            return node->next[level];
+        }
+        return {nullptr, total_};
+    }
+
+    static bool sameKey(const Node *a, const Node *b) {
+        if (!a || !b) {
+            return a == b;
+        }
+        return !(a->key < b->key) && !(b->key < a->key);
+    }
+
+    /**
+     * @brief Compares the region between the matched nodes (@p a, @p b) and
+     * (@p endA, @p endB) at @p level and below.
+     *
+     * Both start nodes hold the same key (or are both heads) and both end
+     * nodes hold the same key (or are both null), and every node reached at
+     * @p level is at least @p level + 1 high in both lists.
+     */
+    template <typename Visitor>
+    std::size_t diffRange(const MerkleSkipList &other, const Node *a,
+                          const Node *b, const Node *endA,
+                          [[maybe_unused]] const Node *endB, int level,
+                          Visitor &visit) const {
+        assert(sameKey(endA, endB));
+        std::size_t found = 0;
+        while (a != endA) {
+            Link la = linkAt(a, level);
+            Link lb = other.linkAt(b, level);
+            const Node *qa = la.node;
+            const Node *qb = lb.node;
+
+            if (sameKey(qa, qb)) {
+                if (la.span != lb.span) {
+                    assert(level > 0);
+                    found +=
+                        diffRange(other, a, b, qa, qb, level - 1, visit);
+                }
+            } else {
+                // Run to the next boundary both lists share at this level
+                while (!sameKey(qa, qb)) {
+                    if (!qb || (qa && qa->key < qb->key)) {
+                        qa = qa->next[level].node;
+                    } else {
+                        qb = qb->next[level].node;
+                    }
+                }
+                if (level > 0) {
+                    found +=
+                        diffRange(other, a, b, qa, qb, level - 1, visit);
+                } else {
+                    found += reportRun(la.node, qa, lb.node, qb, visit);
+                }
+            }
+            a = qa;
+            b = qb;
+        }
+        return found;
+    }
+
+    /**
+     * @brief Merges two runs of level 0 and reports the keys found in only
+     * one of them.
+     */
+    template <typename Visitor>
+    static std::size_t reportRun(const Node *x, const Node *xEnd,
+                                 const Node *y, const Node *yEnd,
+                                 Visitor &visit) {
+        std::size_t found = 0;
+        while (x != xEnd || y != yEnd) {
+            if (y == yEnd || (x != xEnd && x->key < y->key)) {
+                visit(x->key, true);
+                x = x->next[0].node;
+                ++found;
+            } else if (x == xEnd || y->key < x->key) {
+                visit(y->key, false);
+                y = y->next[0].node;
+                ++found;
+            } else {
+                x = x->next[0].node;
+                y = y->next[0].node;
+            }
+        }
+        return found;
+    }
+
+    Node *head_;
+    int maxLevel_ = 1;
+    int maxAllowedLevel_;
+    double probability_;
+    std::size_t size_ = 0;
+    std::uint64_t total_ = 0; ///< Digest of all keys
+
+    std::vector<Node *> update_;      ///< Scratch of findPreds()
+    std::vector<std::uint64_t> rank_; ///< Scratch of findPreds()
+};
+
+#endif // MERKLE_SKIP_LIST_HPP
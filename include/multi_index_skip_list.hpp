@@ -0,0 +1,322 @@
+#ifndef MULTI_INDEX_SKIP_LIST_HPP
+#define MULTI_INDEX_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Set of records kept in several orders at once.
+ *
+ * Every record is stored in one node that carries one tower per index, all
+ * in a single allocation right after the record, so a record is allocated
+ * and copied once whatever the number of indexes, and insert() and erase()
+ * update every index in one call.
+ *
+ * Index 0 is the primary order and must identify records uniquely; an
+ * insert whose record is equivalent to a stored one under it is rejected.
+ * The other indexes may hold equivalent records: ties are broken by the
+ * primary order, so each index is a strict total order and a record is
+ * found in every index in expected O(log n).
+ *
+ * Records are immutable while stored.
+ *
+ * @tparam Record   type of the stored records
+ * @tparam Compares one strict weak ordering of Record per index, the first
+ * being the primary one
+ */
+template <typename Record, typename... Compares> class MultiIndexSkipList {
+    static_assert(sizeof...(Compares) > 0, "at least one index is needed");
+
+    static constexpr std::size_t kIndexes = sizeof...(Compares);
+    static constexpr int kMaxLevel = 32;
+
+    /**
+     * @brief Record followed in memory by its towers, index after index.
+     */
+    struct alignas(alignof(void *)) Node {
+        Record record;
+        std::array<std::uint8_t, kIndexes> height;
+        std::array<std::uint16_t, kIndexes> offset; ///< Of each tower
+
+        Node **tower(std::size_t index) {
+            return reinterpret_cast<Node **>(this + 1) + offset[index];
+        }
+    };
+
+  public:
+    /**
+     * @brief Forward iterator over the records in the order of index @p I.
+     */
+    template <std::size_t I> class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Record;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Record *;
+        using reference = const Record &;
+
+        Iterator() = default;
+        explicit Iterator(Node *node) : node_(node) {}
+
+        reference operator*() const { return node_->record; }
+        pointer operator->() const { return &node_->record; }
+
+        Iterator &operator++() {
+            node_ = node_->tower(I)[0];
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return node_ == other.node_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return node_ != other.node_;
+        }
+
+      private:
+        Node *node_ = nullptr;
+    };
+
+    /**
+     * @brief Constructs an empty container with default-constructed
+     * comparators.
+     *
+     * @param probability Probability p of promoting a node to the next level
+     */
+    explicit MultiIndexSkipList(double probability = 0.5)
+        : MultiIndexSkipList(probability, Compares()...) {}
+
+    /**
+     * @brief Constructs an empty container.
+     *
+     * @param probability Probability p of promoting a node to the next level
+     * @param compares    Comparator instances, one per index
+     */
+    MultiIndexSkipList(double probability, Compares... compares)
+        : compares_(std::move(compares)...), probability_(probability),
+          rngState_(skip_list_detail::nextSeed()) {
+        for (auto &head : heads_) {
+            head.fill(nullptr);
+        }
+        levels_.fill(1);
+    }
+
+    ~MultiIndexSkipList() {
+        Node *node = heads_[0][0];
+        while (node) {
+            Node *next = node->tower(0)[0];
+            destroy(node);
+            node = next;
+        }
+    }
+
+    MultiIndexSkipList(const MultiIndexSkipList &) = delete;
+    MultiIndexSkipList &operator=(const MultiIndexSkipList &) = delete;
+
+    /**
+     * @brief Inserts a record into every index.
+     *
+     * @return Iterator (in primary order) to the stored record and true, or
+     * to the equivalent record already present and false.
+     */
+    std::pair<Iterator<0>, bool> insert(Record record) {
+        Paths update;
+        Node *found = findPreds<0>(record, update[0]);
+        if (found && !primary()(record, found->record)) {
+            return {Iterator<0>(found), false};
+        }
+        forEachIndex([&](auto index) {
+            if constexpr (index.value > 0) {
+                findPreds<index.value>(record, update[index.value]);
+            }
+        });
+
+        std::array<std::uint8_t, kIndexes> height;
+        std::size_t links = 0;
+        for (std::size_t i = 0; i < kIndexes; ++i) {
+            height[i] = static_cast<std::uint8_t>(randomLevel(i));
+            links += height[i];
+        }
+
+        void *memory = ::operator new(sizeof(Node) + links * sizeof(Node *));
+        Node *node = new (memory) Node{std::move(record), height, {}};
+        std::uint16_t offset = 0;
+        for (std::size_t i = 0; i < kIndexes; ++i) {
+            node->offset[i] = offset;
+            offset += height[i];
+
+            for (int l = levels_[i]; l < height[i]; ++l) {
+                update[i][l] = heads_[i].data();
+            }
+            levels_[i] = std::max<int>(levels_[i], height[i]);
+
+            Node **tower = node->tower(i);
+            for (int l = 0; l < height[i]; ++l) {
+                tower[l] = update[i][l][l];
+                update[i][l][l] = node;
+            }
+        }
+        ++size_;
+        return {Iterator<0>(node), true};
+    }
+
+    /**
+     * @brief Removes the record equivalent to @p probe under the primary
+     * order from every index.
+     *
+     * @return false if no such record is stored.
+     */
+    bool erase(const Record &probe) {
+        Paths update;
+        Node *node = findPreds<0>(probe, update[0]);
+        if (!node || primary()(probe, node->record)) {
+            return false;
+        }
+        forEachIndex([&](auto index) {
+            if constexpr (index.value > 0) {
+                findPreds<index.value>(node->record, update[index.value]);
+            }
+        });
+
+        for (std::size_t i = 0; i < kIndexes; ++i) {
+            Node **tower = node->tower(i);
+            for (int l = 0; l < node->height[i]; ++l) {
+                update[i][l][l] = tower[l];
+            }
+            while (levels_[i] > 1 && heads_[i][levels_[i] - 1] == nullptr) {
+                --levels_[i];
+            }
+        }
+        destroy(node);
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief First record of index @p I not ordered before @p probe.
+     *
+     * Only the comparator of index @p I is applied to @p probe, so for a
+     * secondary index only the fields it compares need to be set.
+     */
+    template <std::size_t I>
+    Iterator<I> lower_bound(const Record &probe) const {
+        const auto &less = std::get<I>(compares_);
+        Node *const *links = heads_[I].data();
+        for (int l = levels_[I] - 1; l >= 0; --l) {
+            while (links[l] && less(links[l]->record, probe)) {
+                links = links[l]->tower(I);
+            }
+        }
+        return Iterator<I>(links[0]);
+    }
+
+    /**
+     * @brief First record of index @p I equivalent to @p probe, or end().
+     */
+    template <std::size_t I> Iterator<I> find(const Record &probe) const {
+        Iterator<I> it = lower_bound<I>(probe);
+        if (it != end<I>() && std::get<I>(compares_)(probe, *it)) {
+            return end<I>();
+        }
+        return it;
+    }
+
+    bool contains(const Record &probe) const {
+        return find<0>(probe) != end<0>();
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    template <std::size_t I = 0> Iterator<I> begin() const {
+        return Iterator<I>(heads_[I][0]);
+    }
+    template <std::size_t I = 0> Iterator<I> end() const {
+        return Iterator<I>(nullptr);
+    }
+
+  private:
+    /// Predecessor tower (as a pointer to its links) at every level, per index
+    using Paths = std::array<std::array<Node **, kMaxLevel>, kIndexes>;
+
+    const auto &primary() const { return std::get<0>(compares_); }
+
+    template <typename Fn> static void forEachIndex(Fn fn) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (fn(std::integral_constant<std::size_t, I>{}), ...);
+        }(std::make_index_sequence<kIndexes>{});
+    }
+
+    /**
+     * @brief Order of index @p I with ties broken by the primary order.
+     */
+    template <std::size_t I>
+    bool before(const Record &a, const Record &b) const {
+        if constexpr (I == 0) {
+            return primary()(a, b);
+        } else {
+            const auto &less = std::get<I>(compares_);
+            if (less(a, b)) {
+                return true;
+            }
+            return !less(b, a) && primary()(a, b);
+        }
+    }
+
+    /**
+     * @brief Fills @p update with the predecessors of @p record in index
+     * @p I.
+     *
+     * @return The first node not ordered before @p record.
+     */
+    template <std::size_t I>
+    Node *findPreds(const Record &record,
+                    std::array<Node **, kMaxLevel> &update) {
+        Node **links = heads_[I].data();
+        for (int l = levels_[I] - 1; l >= 0; --l) {
+            while (links[l] && before<I>(links[l]->record, record)) {
+                links = links[l]->tower(I);
+            }
+            update[l] = links;
+        }
+        return links[0];
+    }
+
+    int randomLevel(std::size_t index) {
+        int level = 1;
+        while (level < kMaxLevel && level < levels_[index] + 1 &&
+               skip_list_detail::toUnit(
+                   skip_list_detail::splitmix64(rngState_)) < probability_) {
+            ++level;
+        }
+        return level;
+    }
+
+    static void destroy(Node *node) {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    std::tuple<Compares...> compares_;
+    std::array<std::array<Node *, kMaxLevel>, kIndexes> heads_;
+    std::array<int, kIndexes> levels_; ///< Current height of each index
+    std::size_t size_ = 0;
+    double probability_;
+    std::uint64_t rngState_;
+};
+
+#endif // MULTI_INDEX_SKIP_LIST_HPP
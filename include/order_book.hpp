@@ -0,0 +1,236 @@
+#ifndef ORDER_BOOK_HPP
+#define ORDER_BOOK_HPP
+
+#include "skip_list_map.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+enum class Side { Buy, Sell };
+
+/**
+ * @brief Limit order resting in or submitted to an OrderBook.
+ */
+struct Order {
+    std::uint64_t id;
+    Side side;
+    std::int64_t price;
+    std::uint64_t quantity;
+};
+
+/**
+ * @brief Execution between a resting and an incoming order.
+ */
+struct Trade {
+    std::uint64_t restingId;
+    std::uint64_t incomingId;
+    std::int64_t price; ///< Price of the resting order
+    std::uint64_t quantity;
+};
+
+/**
+ * @brief Orders resting at one price, in time priority.
+ */
+struct PriceLevel {
+    std::list<Order> orders;
+    std::uint64_t quantity = 0; ///< Sum of the resting quantities
+};
+
+/**
+ * @brief One side of an order book: price levels kept in a SkipListMap.
+ *
+ * Levels are ordered so that the best price is always the first entry of
+ * the map, which makes best() O(1). Bids are stored under the bitwise
+ * complement of the price (~price = -price - 1) to get that order from the
+ * ascending skip list; unlike negation it is defined for every price.
+ */
+class BookSide {
+  public:
+    using Levels = SkipListMap<std::int64_t, PriceLevel>;
+    using LevelIterator = Levels::Iterator;
+
+    explicit BookSide(Side side) : side_(side) {}
+
+    /**
+     * @brief Best price of this side, if any order rests on it.
+     */
+    std::optional<std::int64_t> best() const {
+        if (levels_.empty()) {
+            return std::nullopt;
+        }
+        return priceOf(levels_.begin()->key);
+    }
+
+    /**
+     * @brief Level holding the best price, or end() if the side is empty.
+     */
+    LevelIterator bestLevel() const { return levels_.begin(); }
+    LevelIterator end() const { return levels_.end(); }
+
+    /**
+     * @brief Returns the level for @p price, creating it if necessary.
+     */
+    LevelIterator level(std::int64_t price) {
+        return levels_.emplace(keyOf(price), PriceLevel{}).first;
+    }
+
+    /**
+     * @brief Removes a level that no longer holds orders.
+     */
+    void removeLevel(LevelIterator level) { levels_.erase(level->key); }
+
+    /**
+     * @brief Total resting quantity at @p price.
+     */
+    std::uint64_t quantityAt(std::int64_t price) const {
+        auto it = levels_.find(keyOf(price));
+        return it == levels_.end() ? 0 : it->value.quantity;
+    }
+
+    std::size_t levelCount() const { return levels_.size(); }
+
+    /**
+     * @brief Whether an incoming order at @p price can trade with a resting
+     * order of this side at @p resting.
+     */
+    bool crosses(std::int64_t price, std::int64_t resting) const {
+        return side_ == Side::Buy ? price <= resting : price >= resting;
+    }
+
+    std::int64_t priceOf(std::int64_t key) const {
+        return side_ == Side::Buy ? ~key : key;
+    }
+
+  private:
+    std::int64_t keyOf(std::int64_t price) const {
+        return side_ == Side::Buy ? ~price : price;
+    }
+
+    Side side_;
+    Levels levels_;
+};
+
+/**
+ * @brief Price-time priority limit order book with a matching engine.
+ *
+ * Each side is a BookSide; every resting order is also indexed by id with
+ * the position of its level and of its entry in the level FIFO, so a cancel
+ * unlinks the order in O(1) and only touches the skip list when its level
+ * becomes empty.
+ */
+class OrderBook {
+  public:
+    /**
+     * @brief Matches an incoming limit order and rests what remains.
+     *
+     * @return The trades produced, in execution order.
+     */
+    std::vector<Trade> submit(const Order &order) {
+        std::vector<Trade> trades;
+        submit(order, trades);
+        return trades;
+    }
+
+    /**
+     * @brief Same as submit(const Order &) but appends the trades to
+     * @p trades, so a caller can reuse one buffer.
+     *
+     * @return false if an order with the same id is already resting.
+     */
+    bool submit(const Order &order, std::vector<Trade> &trades) {
+        if (index_.count(order.id)) {
+            return false;
+        }
+        BookSide &opposite = order.side == Side::Buy ? asks_ : bids_;
+        std::uint64_t left = order.quantity;
+
+        while (left > 0) {
+            auto level = opposite.bestLevel();
+            if (level == opposite.end() ||
+                !opposite.crosses(order.price, opposite.priceOf(level->key))) {
+                break;
+            }
+            PriceLevel &resting = level->value;
+            while (left > 0 && !resting.orders.empty()) {
+                Order &front = resting.orders.front();
+                std::uint64_t qty = std::min(left, front.quantity);
+                trades.push_back({front.id, order.id, front.price, qty});
+                front.quantity -= qty;
+                resting.quantity -= qty;
+                left -= qty;
+                if (front.quantity == 0) {
+                    index_.erase(front.id);
+                    resting.orders.pop_front();
+                }
+            }
+            if (resting.orders.empty()) {
+                opposite.removeLevel(level);
+            }
+        }
+
+        if (left > 0) {
+            BookSide &own = sideOf(order.side);
+            auto level = own.level(order.price);
+            PriceLevel &pl = level->value;
+            pl.orders.push_back(order);
+            pl.orders.back().quantity = left;
+            pl.quantity += left;
+            index_.emplace(order.id, Locator{order.side, level,
+                                             std::prev(pl.orders.end())});
+        }
+        return true;
+    }
+
+    /**
+     * @brief Cancels a resting order.
+     *
+     * @return false if no order with this id is resting.
+     */
+    bool cancel(std::uint64_t id) {
+        auto found = index_.find(id);
+        if (found == index_.end()) {
+            return false;
+        }
+        Locator loc = found->second;
+        index_.erase(found);
+
+        PriceLevel &pl = loc.level->value;
+        pl.quantity -= loc.order->quantity;
+        pl.orders.erase(loc.order);
+        if (pl.orders.empty()) {
+            sideOf(loc.side).removeLevel(loc.level);
+        }
+        return true;
+    }
+
+    std::optional<std::int64_t> bestBid() const { return bids_.best(); }
+    std::optional<std::int64_t> bestAsk() const { return asks_.best(); }
+
+    const BookSide &bids() const { return bids_; }
+    const BookSide &asks() const { return asks_; }
+
+    /**
+     * @brief Number of resting orders.
+     */
+    std::size_t orderCount() const { return index_.size(); }
+
+  private:
+    struct Locator {
+        Side side;
+        BookSide::LevelIterator level;
+        std::list<Order>::iterator order;
+    };
+
+    BookSide &sideOf(Side side) { return side == Side::Buy ? bids_ : asks_; }
+
+    BookSide bids_{Side::Buy};
+    BookSide asks_{Side::Sell};
+    std::unordered_map<std::uint64_t, Locator> index_;
+};
+
+#endif // ORDER_BOOK_HPP
@@ -0,0 +1,229 @@
+#ifndef PARALLEL_SET_OPS_HPP
+#define PARALLEL_SET_OPS_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace parallel_set_ops_detail {
+
+/// Partitions per thread, so that threads done early take over the rest
+inline constexpr std::size_t kPartsPerThread = 4;
+
+/**
+ * @brief Key range [lo, hi) of one partition; a null bound is open.
+ */
+template <typename Key> struct Range {
+    const Key *lo;
+    const Key *hi;
+
+    typename SkipList<Key>::Iterator first(const SkipList<Key> &list) const {
+        return lo ? list.lower_bound(*lo) : list.begin();
+    }
+    bool below(const Key &key) const { return !hi || key < *hi; }
+};
+
+/**
+ * @brief Picks up to parts - 1 ascending splitters that cut the union of
+ * @p lists into ranges of similar sizes.
+ *
+ * Each list contributes keys sampled from its upper levels, so the cost
+ * does not depend on the list sizes.
+ */
+template <typename Key>
+std::vector<Key> pickSplitters(const std::vector<const SkipList<Key> *> &lists,
+                               std::size_t parts) {
+    std::vector<Key> samples;
+    for (const auto *list : lists) {
+        std::vector<Key> keys = list->sampleKeys(parts * kPartsPerThread);
+        samples.insert(samples.end(), keys.begin(), keys.end());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    std::vector<Key> splitters;
+    for (std::size_t p = 1; p < parts && !samples.empty(); ++p) {
+        const Key &key = samples[p * samples.size() / parts];
+        if (splitters.empty() || splitters.back() < key) {
+            splitters.push_back(key);
+        }
+    }
+    return splitters;
+}
+
+/**
+ * @brief Runs task(p) for every p < @p parts on @p threads threads, the
+ * calling one included.
+ *
+ * Each thread takes the next partition nobody took yet, so a thread that
+ * drew small partitions keeps taking work from the shared queue until it
+ * is empty.
+ */
+template <typename Task>
+void forEachPartition(std::size_t parts, unsigned threads, Task task) {
+    std::atomic<std::size_t> next{0};
+    auto work = [&] {
+        for (std::size_t p; (p = next.fetch_add(1, std::memory_order_relaxed)) <
+                            parts;) {
+            task(p);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads && t < parts; ++t) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : pool) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Cuts the key space by splitters, lets build(range, keys) append
+ * the ascending result keys of each range on the thread pool, turns every
+ * range into a segment list and stitches the segments with
+ * SkipList::append().
+ */
+template <typename Key, typename Build>
+SkipList<Key> runPartitioned(const std::vector<const SkipList<Key> *> &lists,
+                             unsigned threads, Build build) {
+    threads = std::max(1u, threads);
+    std::vector<Key> splitters =
+        threads == 1 ? std::vector<Key>()
+                     : pickSplitters(lists, threads * kPartsPerThread);
+    const std::size_t parts = splitters.size() + 1;
+
+    std::vector<SkipList<Key>> segments(parts);
+    forEachPartition(parts, threads, [&](std::size_t p) {
+        Range<Key> range{p > 0 ? &splitters[p - 1] : nullptr,
+                         p + 1 < parts ? &splitters[p] : nullptr};
+        std::vector<Key> keys;
+        build(range, keys);
+        segments[p].insertSorted(keys.begin(), keys.end());
+    });
+
+    SkipList<Key> result = std::move(segments[0]);
+    for (std::size_t p = 1; p < parts; ++p) {
+        result.append(std::move(segments[p]));
+    }
+    return result;
+}
+
+} // namespace parallel_set_ops_detail
+
+/**
+ * @brief Builds the list of the keys present in at least one of @p lists
+ * on @p threads threads; uniting two lists merges them.
+ *
+ * The key space is cut into ranges by splitters sampled from the upper
+ * levels of the inputs. Every range is merged from all inputs into its own
+ * segment list in parallel, and the segments are then linked end to end,
+ * which costs O(log n) per segment. The inputs are only read.
+ */
+template <typename Key>
+SkipList<Key>
+parallelUnite(const std::vector<const SkipList<Key> *> &lists,
+              unsigned threads = std::thread::hardware_concurrency()) {
+    using parallel_set_ops_detail::Range;
+    return parallel_set_ops_detail::runPartitioned(
+        lists, threads, [&](const Range<Key> &range, std::vector<Key> &out) {
+            std::vector<typename SkipList<Key>::Iterator> at;
+            for (const auto *list : lists) {
+                at.push_back(range.first(*list));
+            }
+            auto live = [&](std::size_t i) {
+                return at[i] != lists[i]->end() && range.below(*at[i]);
+            };
+            // The inputs are few: a linear scan for the minimum beats a heap
+            for (;;) {
+                const Key *min = nullptr;
+                for (std::size_t i = 0; i < at.size(); ++i) {
+                    if (live(i) && (!min || *at[i] < *min)) {
+                        min = &*at[i];
+                    }
+                }
+                if (!min) {
+                    break;
+                }
+                out.push_back(*min);
+                const Key &key = out.back();
+                for (std::size_t i = 0; i < at.size(); ++i) {
+                    if (live(i) && !(key < *at[i])) {
+                        ++at[i];
+                    }
+                }
+            }
+        });
+}
+
+/**
+ * @brief Builds the list of the keys present in all of @p lists on
+ * @p threads threads.
+ *
+ * Partitioned like parallelUnite(); within a range the lists are
+ * intersected as in intersectLists(), the smallest list proposing
+ * candidates and the others skipping to them with finger searches.
+ */
+template <typename Key>
+SkipList<Key>
+parallelIntersect(std::vector<const SkipList<Key> *> lists,
+                  unsigned threads = std::thread::hardware_concurrency()) {
+    using parallel_set_ops_detail::Range;
+    if (lists.empty()) {
+        return SkipList<Key>();
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const SkipList<Key> *a, const SkipList<Key> *b) {
+                  return a->size() < b->size();
+              });
+    return parallel_set_ops_detail::runPartitioned(
+        lists, threads, [&](const Range<Key> &range, std::vector<Key> &out) {
+            const std::size_t k = lists.size();
+            std::vector<typename SkipList<Key>::Finger> fingers;
+            std::vector<typename SkipList<Key>::Iterator> at;
+            for (const auto *list : lists) {
+                fingers.push_back(list->finger());
+                at.push_back(range.lo ? list->seek(fingers.back(), *range.lo)
+                                      : list->begin());
+                if (at.back() == list->end()) {
+                    return;
+                }
+            }
+
+            Key candidate = *at[0];
+            std::size_t agree = 1; ///< Lists known to contain the candidate
+            std::size_t i = 1 % k;
+            while (range.below(candidate)) {
+                if (agree == k) {
+                    out.push_back(candidate);
+                    if (++at[0] == lists[0]->end()) {
+                        break;
+                    }
+                    candidate = *at[0];
+                    agree = 1;
+                    i = 1 % k;
+                    continue;
+                }
+                auto &it = at[i];
+                if (*it < candidate) {
+                    it = lists[i]->seek(fingers[i], candidate);
+                    if (it == lists[i]->end()) {
+                        break;
+                    }
+                }
+                if (candidate < *it) {
+                    candidate = *it;
+                    agree = 1;
+                } else {
+                    ++agree;
+                }
+                i = (i + 1) % k;
+            }
+        });
+}
+
+#endif // PARALLEL_SET_OPS_HPP
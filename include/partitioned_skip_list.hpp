@@ -0,0 +1,367 @@
+#ifndef PARTITIONED_SKIP_LIST_HPP
+#define PARTITIONED_SKIP_LIST_HPP
+
+#include "skip_list.hpp"
+#include "spsc_ring.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Shared-nothing set split by key range over worker threads.
+ *
+ * Each partition owns the keys of one range in a plain SkipList that only
+ * its worker thread touches, so the list needs no locks and no atomics.
+ * Other threads act through a Client, which talks to every worker over a
+ * pair of SpscRing queues (requests in, responses out): with one pair per
+ * client and partition, every ring has exactly one producer and one
+ * consumer. Workers drain requests in batches and answer them in order.
+ *
+ * scan() visits a key range in ascending order across partitions: the
+ * client asks the partitions one after the other, and each worker streams
+ * the keys back in as many rounds as the response ring needs, serving the
+ * other clients between rounds.
+ *
+ * @tparam Key type of key, must be LessThanComparable, copyable and default
+ * constructible
+ */
+template <typename Key> class PartitionedSkipList {
+  private:
+    static constexpr std::size_t kBatch = 64; ///< Ring entries per pop
+
+    enum class Kind : std::uint8_t { Insert, Erase, Contains, Scan, Size };
+
+    struct Request {
+        Kind kind = Kind::Contains;
+        Key key{};
+        Key hi{}; ///< End of a scanned range
+    };
+
+    struct Response {
+        bool ok = false;
+        bool end = false;      ///< Last response of a scan or size request
+        Key key{};             ///< Scanned key
+        std::size_t count = 0; ///< Answer of a size request
+    };
+
+    /**
+     * @brief Scan being streamed to a client.
+     */
+    struct ScanState {
+        bool active = false;
+        Key next{}; ///< Keys before it were already sent
+        Key hi{};
+    };
+
+    struct Channel {
+        explicit Channel(std::size_t capacity)
+            : requests(capacity), responses(capacity) {}
+
+        SpscRing<Request> requests;
+        SpscRing<Response> responses;
+        ScanState scan; ///< Only used by the worker
+    };
+
+    struct Partition {
+        SkipList<Key> list;
+        std::vector<std::unique_ptr<Channel>> channels; ///< One per client
+        std::thread worker;
+    };
+
+  public:
+    /**
+     * @brief Operation of a batch passed to Client::apply().
+     */
+    struct Op {
+        /// Same values as the matching request kinds
+        enum Type : std::uint8_t { Insert, Erase, Contains } type;
+        Key key;
+    };
+
+    /**
+     * @brief Access point of one thread; not thread-safe itself.
+     */
+    class Client {
+      public:
+        bool insert(const Key &key) { return call(Kind::Insert, key); }
+        bool erase(const Key &key) { return call(Kind::Erase, key); }
+        bool contains(const Key &key) { return call(Kind::Contains, key); }
+
+        /**
+         * @brief Sends a batch of operations and waits for all of them.
+         *
+         * Requests to different partitions are processed in parallel; the
+         * operations on one key are applied in batch order.
+         *
+         * @return The result of each operation, in batch order.
+         */
+        std::vector<bool> apply(const std::vector<Op> &ops) {
+            std::vector<bool> results(ops.size());
+            for (std::size_t i = 0; i < ops.size(); ++i) {
+                std::size_t p = owner_->partitionOf(ops[i].key);
+                Channel &ch = channel(p);
+                // Never more requests in flight than the responses ring
+                // holds, so the worker can always answer
+                while (pending_[p].size() == ch.responses.capacity()) {
+                    collect(results);
+                }
+                bool pushed = ch.requests.tryPush(
+                    {static_cast<Kind>(ops[i].type), ops[i].key, Key{}});
+                assert(pushed);
+                (void)pushed;
+                pending_[p].push_back(i);
+                ++inFlight_;
+            }
+            while (inFlight_ > 0) {
+                collect(results);
+            }
+            return results;
+        }
+
+        /**
+         * @brief Calls visit(const Key &) on the keys in [lo, hi) in
+         * ascending order.
+         */
+        template <typename Visitor>
+        void scan(const Key &lo, const Key &hi, Visitor visit) {
+            if (!(lo < hi)) {
+                return;
+            }
+            std::size_t last = owner_->partitionOf(hi);
+            for (std::size_t p = owner_->partitionOf(lo); p <= last; ++p) {
+                Channel &ch = channel(p);
+                push(ch, {Kind::Scan, lo, hi});
+                stream(ch, [&](const Response &r) { visit(r.key); });
+            }
+        }
+
+        /**
+         * @brief Number of keys over all partitions.
+         */
+        std::size_t size() {
+            std::size_t total = 0;
+            for (std::size_t p = 0; p < pending_.size(); ++p) {
+                Channel &ch = channel(p);
+                push(ch, {Kind::Size, Key{}, Key{}});
+                total += stream(ch, [](const Response &) {}).count;
+            }
+            return total;
+        }
+
+      private:
+        friend class PartitionedSkipList;
+
+        Client(PartitionedSkipList &owner, std::size_t index)
+            : owner_(&owner), index_(index),
+              pending_(owner.partitions_.size()) {}
+
+        Channel &channel(std::size_t p) {
+            return *owner_->partitions_[p]->channels[index_];
+        }
+
+        bool call(Kind kind, const Key &key) {
+            Channel &ch = channel(owner_->partitionOf(key));
+            push(ch, {kind, key, Key{}});
+            Response r;
+            while (!ch.responses.tryPop(r)) {
+                std::this_thread::yield();
+            }
+            return r.ok;
+        }
+
+        static void push(Channel &ch, const Request &request) {
+            while (!ch.requests.tryPush(request)) {
+                std::this_thread::yield();
+            }
+        }
+
+        /**
+         * @brief Hands every response before the end marker to @p handle.
+         *
+         * @return The end marker.
+         */
+        template <typename Handler>
+        static Response stream(Channel &ch, Handler handle) {
+            std::array<Response, kBatch> batch;
+            for (;;) {
+                std::size_t n = ch.responses.popBatch(batch.data(), kBatch);
+                if (n == 0) {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < n; ++i) {
+                    if (batch[i].end) {
+                        assert(i + 1 == n);
+                        return batch[i];
+                    }
+                    handle(batch[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Takes the responses that arrived and stores their results.
+         */
+        void collect(std::vector<bool> &results) {
+            std::size_t got = 0;
+            for (std::size_t p = 0; p < pending_.size(); ++p) {
+                Response r;
+                while (!pending_[p].empty() &&
+                       channel(p).responses.tryPop(r)) {
+                    results[pending_[p].front()] = r.ok;
+                    pending_[p].pop_front();
+                    ++got;
+                }
+            }
+            inFlight_ -= got;
+            if (got == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        PartitionedSkipList *owner_;
+        std::size_t index_;
+        std::vector<std::deque<std::size_t>> pending_; ///< Per partition
+        std::size_t inFlight_ = 0;
+    };
+
+    /**
+     * @brief Starts one worker per partition.
+     *
+     * @param splitters     Ascending keys separating the partitions:
+     * partition p holds the keys in [splitters[p - 1], splitters[p])
+     * @param clients       Number of clients, i.e. of threads that may use
+     * the set at the same time
+     * @param queueCapacity Capacity of each ring
+     */
+    PartitionedSkipList(std::vector<Key> splitters, std::size_t clients,
+                        std::size_t queueCapacity = 1024)
+        : splitters_(std::move(splitters)) {
+        assert(std::is_sorted(splitters_.begin(), splitters_.end()));
+        for (std::size_t p = 0; p <= splitters_.size(); ++p) {
+            auto part = std::make_unique<Partition>();
+            for (std::size_t c = 0; c < clients; ++c) {
+                part->channels.push_back(
+                    std::make_unique<Channel>(queueCapacity));
+            }
+            partitions_.push_back(std::move(part));
+        }
+        for (std::size_t c = 0; c < clients; ++c) {
+            clients_.push_back(std::unique_ptr<Client>(new Client(*this, c)));
+        }
+        for (auto &part : partitions_) {
+            part->worker = std::thread([this, p = part.get()] { run(*p); });
+        }
+    }
+
+    ~PartitionedSkipList() {
+        stop_.store(true, std::memory_order_relaxed);
+        for (auto &part : partitions_) {
+            part->worker.join();
+        }
+    }
+
+    PartitionedSkipList(const PartitionedSkipList &) = delete;
+    PartitionedSkipList &operator=(const PartitionedSkipList &) = delete;
+
+    /**
+     * @brief Client number @p index; each must be used by one thread at a
+     * time.
+     */
+    Client &client(std::size_t index) { return *clients_[index]; }
+
+    std::size_t partitionCount() const { return partitions_.size(); }
+
+    /**
+     * @brief Partition owning @p key.
+     */
+    std::size_t partitionOf(const Key &key) const {
+        return std::upper_bound(splitters_.begin(), splitters_.end(), key) -
+               splitters_.begin();
+    }
+
+  private:
+    void run(Partition &part) {
+        std::array<Request, kBatch> batch;
+        while (!stop_.load(std::memory_order_relaxed)) {
+            bool busy = false;
+            for (auto &ch : part.channels) {
+                if (ch->scan.active) {
+                    continueScan(part.list, *ch);
+                    busy = true;
+                    continue; // Later requests wait for the scan to end
+                }
+                std::size_t n = ch->requests.popBatch(batch.data(), kBatch);
+                for (std::size_t i = 0; i < n; ++i) {
+                    handle(part.list, *ch, batch[i]);
+                }
+                busy = busy || n > 0;
+            }
+            if (!busy) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    static void handle(SkipList<Key> &list, Channel &ch, const Request &req) {
+        Response r;
+        switch (req.kind) {
+        case Kind::Insert:
+            r.ok = list.insert(req.key).second;
+            break;
+        case Kind::Erase:
+            r.ok = list.erase(req.key);
+            break;
+        case Kind::Contains:
+            r.ok = list.contains(req.key);
+            break;
+        case Kind::Scan:
+            ch.scan = {true, req.key, req.hi};
+            continueScan(list, ch);
+            return;
+        case Kind::Size:
+            r.end = true;
+            r.count = list.size();
+            break;
+        }
+        // Clients never have more requests in flight than fit in the ring
+        bool pushed = ch.responses.tryPush(r);
+        assert(pushed);
+        (void)pushed;
+    }
+
+    /**
+     * @brief Sends the next keys of the scan of @p ch, as many as the ring
+     * takes, and the end marker once they are all sent.
+     */
+    static void continueScan(const SkipList<Key> &list, Channel &ch) {
+        ScanState &scan = ch.scan;
+        for (auto it = list.lower_bound(scan.next);
+             it != list.end() && *it < scan.hi; ++it) {
+            if (!ch.responses.tryPush({true, false, *it, 0})) {
+                // The list may change before the next round: resume by key
+                scan.next = *it;
+                return;
+            }
+        }
+        scan.next = scan.hi;
+        if (ch.responses.tryPush({true, true, Key{}, 0})) {
+            scan.active = false;
+        }
+    }
+
+    std::vector<Key> splitters_;
+    std::vector<std::unique_ptr<Partition>> partitions_;
+    std::vector<std::unique_ptr<Client>> clients_;
+    std::atomic<bool> stop_{false};
+};
+
+#endif // PARTITIONED_SKIP_LIST_HPP
@@ -0,0 +1,149 @@
+#ifndef POSTING_LISTS_HPP
+#define POSTING_LISTS_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Calls @p visit for every key present in all of @p lists, in
+ * ascending order.
+ *
+ * Adaptive intersection (Demaine, López-Ortiz and Munro): the lists are
+ * ordered by size so the smallest one proposes the first candidate, then
+ * the lists are visited round-robin and each one skips to the candidate with
+ * SkipList::seek(). A list that holds a larger key there makes that key the
+ * new candidate. Every skip is a finger search over the towers, so a list is
+ * only walked where its keys are close to the result and the total cost
+ * follows the interleaving of the lists instead of their lengths.
+ *
+ * @return Number of keys visited.
+ */
+template <typename Key, typename Visitor>
+std::size_t intersectLists(std::vector<const SkipList<Key> *> lists,
+                           Visitor visit) {
+    if (lists.empty()) {
+        return 0;
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const SkipList<Key> *a, const SkipList<Key> *b) {
+                  return a->size() < b->size();
+              });
+    if (lists.front()->empty()) {
+        return 0;
+    }
+
+    const std::size_t k = lists.size();
+    std::vector<typename SkipList<Key>::Finger> fingers;
+    std::vector<typename SkipList<Key>::Iterator> at; ///< Last seek results
+    fingers.reserve(k);
+    for (const auto *list : lists) {
+        fingers.push_back(list->finger());
+        at.push_back(list->begin());
+    }
+
+    std::size_t found = 0;
+    Key candidate = *at[0];
+    std::size_t agree = 1; ///< Lists known to contain the candidate
+    std::size_t i = 1 % k;
+    while (true) {
+        if (agree == k) {
+            visit(candidate);
+            ++found;
+            if (++at[0] == lists[0]->end()) {
+                break;
+            }
+            candidate = *at[0];
+            agree = 1;
+            i = 1 % k;
+            continue;
+        }
+
+        // The previous skip of a list may already be at or past the
+        // candidate, then the towers are not needed
+        auto &it = at[i];
+        if (*it < candidate) {
+            it = lists[i]->seek(fingers[i], candidate);
+            if (it == lists[i]->end()) {
+                break;
+            }
+        }
+        if (candidate < *it) {
+            candidate = *it;
+            agree = 1;
+        } else {
+            ++agree;
+        }
+        i = (i + 1) % k;
+    }
+    return found;
+}
+
+/**
+ * @brief Returns the keys present in all of @p lists, in ascending order.
+ */
+template <typename Key>
+std::vector<Key> intersectLists(std::vector<const SkipList<Key> *> lists) {
+    std::vector<Key> keys;
+    intersectLists<Key>(std::move(lists),
+                        [&](const Key &key) { keys.push_back(key); });
+    return keys;
+}
+
+/**
+ * @brief Calls @p visit for every key present in at least one of @p lists,
+ * in ascending order and once per key.
+ *
+ * A k-way merge over a heap of list cursors.
+ *
+ * @return Number of keys visited.
+ */
+template <typename Key, typename Visitor>
+std::size_t uniteLists(const std::vector<const SkipList<Key> *> &lists,
+                       Visitor visit) {
+    using Cursor = std::pair<typename SkipList<Key>::Iterator, std::size_t>;
+    auto after = [](const Cursor &a, const Cursor &b) {
+        return *b.first < *a.first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(after)> heap(
+        after);
+    for (std::size_t i = 0; i < lists.size(); ++i) {
+        if (!lists[i]->empty()) {
+            heap.push({lists[i]->begin(), i});
+        }
+    }
+
+    std::size_t found = 0;
+    const Key *last = nullptr;
+    while (!heap.empty()) {
+        Cursor top = heap.top();
+        heap.pop();
+        if (!last || *last < *top.first) {
+            last = &*top.first;
+            visit(*last);
+            ++found;
+        }
+        if (++top.first != lists[top.second]->end()) {
+            heap.push(top);
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Returns the keys present in at least one of @p lists, in ascending
+ * order.
+ */
+template <typename Key>
+std::vector<Key> uniteLists(const std::vector<const SkipList<Key> *> &lists) {
+    std::vector<Key> keys;
+    uniteLists<Key>(lists, [&](const Key &key) { keys.push_back(key); });
+    return keys;
+}
+
+#endif // POSTING_LISTS_HPP
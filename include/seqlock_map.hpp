@@ -0,0 +1,226 @@
+#ifndef SEQLOCK_MAP_HPP
+#define SEQLOCK_MAP_HPP
+
+#include "skip_list_map.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @brief Value guarded by a sequence lock.
+ *
+ * load() writes no shared memory: it copies the value and retries if a
+ * writer was active meanwhile, which the sequence number tells it.
+ * Whatever keeps the value itself alive, such as the map lock of
+ * SeqlockSkipListMap, is up to the owner.
+ * Writers exclude each other by making the sequence number odd with a CAS.
+ * The value is kept in relaxed atomic words, so a torn copy is discarded
+ * rather than being a data race.
+ *
+ * @tparam T trivially copyable value type
+ */
+template <typename T> class SeqlockValue {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "seqlock values are copied word by word");
+
+  public:
+    SeqlockValue() : SeqlockValue(T{}) {}
+    explicit SeqlockValue(const T &value) { put(value); }
+
+    SeqlockValue(const SeqlockValue &other) : SeqlockValue(other.load()) {}
+    SeqlockValue &operator=(const SeqlockValue &other) {
+        store(other.load());
+        return *this;
+    }
+
+    T load() const {
+        for (;;) {
+            std::uint64_t before = seq_.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            T value = get();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) {
+                return value;
+            }
+        }
+    }
+
+    void store(const T &value) {
+        update([&](T &current) { current = value; });
+    }
+
+    /**
+     * @brief Applies @p fn(T &) to the value, serialized with the other
+     * writers.
+     */
+    template <typename Fn> void update(Fn fn) {
+        std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        for (;;) {
+            if (!(seq & 1) && seq_.compare_exchange_weak(
+                                  seq, seq + 1, std::memory_order_acquire,
+                                  std::memory_order_relaxed)) {
+                break;
+            }
+            seq = seq_.load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        T value = get(); // No other writer: this copy is never torn
+        fn(value);
+        put(value);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+  private:
+    static constexpr std::size_t kWords =
+        (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    T get() const {
+        std::array<std::uint64_t, kWords> words;
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        T value;
+        std::memcpy(&value, words.data(), sizeof(T));
+        return value;
+    }
+
+    void put(const T &value) {
+        std::array<std::uint64_t, kWords> words{};
+        std::memcpy(words.data(), &value, sizeof(T));
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<std::uint64_t> seq_{0}; ///< Odd while a writer is active
+    std::array<std::atomic<std::uint64_t>, kWords> words_;
+};
+
+/**
+ * @brief Thread-safe ordered map whose values are updated in place under a
+ * shared lock.
+ *
+ * Structural changes (insert() and erase()) take the map lock exclusively.
+ * Reads and value updates take it shared, which keeps the nodes in place:
+ * updates then synchronize on the seqlock of their own entry, and reads
+ * copy the value optimistically. Updates of different keys therefore run
+ * in parallel, and reads and updates wait only for insert() and erase().
+ * Reads are not lock-free: every call still acquires the map lock.
+ *
+ * @tparam Key   type of key, must be LessThanComparable and default
+ * constructible
+ * @tparam Value trivially copyable value type
+ */
+template <typename Key, typename Value> class SeqlockSkipListMap {
+  public:
+    explicit SeqlockSkipListMap(double probability = 0.5,
+                                int maxAllowedLevel = 32)
+        : map_(probability, maxAllowedLevel) {}
+
+    /**
+     * @brief Inserts a key/value pair unless the key is already present.
+     *
+     * @return true if the pair was inserted.
+     */
+    bool insert(const Key &key, const Value &value) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        return map_.insert(key, Slot(value));
+    }
+
+    /**
+     * @brief Removes a key and its value.
+     *
+     * @return true if the key was found and removed.
+     */
+    bool erase(const Key &key) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        return map_.erase(key);
+    }
+
+    /**
+     * @brief Returns the value of @p key, or nothing if it is absent.
+     */
+    std::optional<Value> load(const Key &key) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            return std::nullopt;
+        }
+        return it->value.load();
+    }
+
+    /**
+     * @brief Overwrites the value of an existing key.
+     *
+     * @return false if the key is absent.
+     */
+    bool store(const Key &key, const Value &value) {
+        return update(key, [&](Value &current) { current = value; });
+    }
+
+    /**
+     * @brief Applies @p fn(Value &) to the value of an existing key in
+     * place.
+     *
+     * @return false if the key is absent.
+     */
+    template <typename Fn> bool update(const Key &key, Fn fn) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            return false;
+        }
+        it->value.update(fn);
+        return true;
+    }
+
+    /**
+     * @brief Applies @p fn(Value &) to the value of @p key, inserting
+     * @p initial first if the key is absent.
+     *
+     * Only the insertion of a new key takes the lock exclusively.
+     */
+    template <typename Fn>
+    void upsert(const Key &key, const Value &initial, Fn fn) {
+        if (update(key, fn)) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        map_.emplace(key, Slot(initial)).first->value.update(fn);
+    }
+
+    /**
+     * @brief Calls visit(const Key &, const Value &) on the entries in key
+     * order.
+     */
+    template <typename Visitor> void forEach(Visitor visit) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto &entry : map_) {
+            visit(entry.key, entry.value.load());
+        }
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return map_.size();
+    }
+
+  private:
+    using Slot = SeqlockValue<Value>;
+
+    mutable std::shared_mutex mutex_; ///< Exclusive for structural changes
+    SkipListMap<Key, Slot> map_;
+};
+
+#endif // SEQLOCK_MAP_HPP
@@ -1,12 +1,122 @@
 #ifndef SKIP_LIST_HPP
 #define SKIP_LIST_HPP
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <new>
 #include <random>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+/**
+ * @brief Receiver of the mutations applied to a SkipList.
+ *
+ * A sink attached with SkipList::setChangeSink() is called after every
+ * insert or erase that actually changed the list, in the order the changes
+ * were made and on the thread that made them.
+ *
+ * @tparam Key type of key stored in the observed list
+ */
+template <typename Key> class ChangeSink {
+  public:
+    virtual ~ChangeSink() = default;
+
+    virtual void onInsert(const Key &key) = 0;
+    virtual void onErase(const Key &key) = 0;
+};
+
+namespace skip_list_detail {
+
+/**
+ * @brief Advances a splitmix64 sequence and returns its next output.
+ */
+inline std::uint64_t splitmix64(std::uint64_t &state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Maps 64 random bits to a uniform double in [0, 1).
+ */
+inline double toUnit(std::uint64_t bits) {
+    return static_cast<double>(bits >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief Nonzero seed for the generator of a new container, from a
+ * per-thread splitmix64 sequence started once from std::random_device.
+ *
+ * Unlike the address of the container, it differs between containers
+ * created at the same address and between runs.
+ */
+inline std::uint64_t nextSeed() {
+    thread_local std::uint64_t state =
+        (std::uint64_t{std::random_device{}()} << 32) ^ std::random_device{}();
+    return splitmix64(state) | 1;
+}
+
+/**
+ * @brief Hints the CPU to start loading @p address into the cache.
+ */
+inline void prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+/// Keys evaluated together by a filtered scan, one bit each in a mask
+inline constexpr std::size_t kScanBatch = 64;
+
+/**
+ * @brief Returns the mask of the @p n (at most kScanBatch) items satisfying
+ * @p pred: bit i is set if items[i] matches.
+ *
+ * The predicate is first evaluated over the whole batch into byte flags, a
+ * loop without branches that the compiler vectorizes for simple predicates
+ * on arithmetic keys. Each 8 flags are then packed into 8 bits by one
+ * multiplication, so the caller visits the matches by counting zeros and
+ * rare matches cost no mispredictions.
+ */
+template <typename Item, typename Pred>
+std::uint64_t matchMask(const Item *items, std::size_t n, Pred pred) {
+    alignas(std::uint64_t) std::uint8_t flags[kScanBatch];
+    for (std::size_t i = 0; i < n; ++i) {
+        flags[i] = static_cast<bool>(pred(items[i]));
+    }
+    std::fill(flags + n, flags + (n + 7) / 8 * 8, std::uint8_t(0));
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < n; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, flags + i, sizeof(word));
+        mask |= (word * 0x0102040810204080ull) >> 56 << i;
+    }
+    return mask;
+}
+
+} // namespace skip_list_detail
+
+/**
+ * @brief How a SkipList chooses the height of a new node.
+ */
+enum class LevelMode {
+    Random, ///< Drawn from the list's generator
+    Hashed  ///< Derived from std::hash of the key, so the layout is canonical
+};
+
 /**
  * @brief Probabilistic skip list with unique keys.
  *
@@ -14,20 +124,57 @@
  * complexity for insert, erase and search operations.
  * Keys are stored in ascending order. Duplicate keys are ignored.
  *
- * @tparam Key type of key, must be LessThanComparable (operator<)
+ * An empty list holds no heap memory: the head node is allocated by the
+ * first insert, and levels are drawn from an 8-byte per-list generator
+ * instead of a full std::mt19937, so many small lists stay cheap.
+ *
+ * Each node is a single allocation holding the key and its tower of
+ * forward pointers, obtained from @p Allocator.
+ *
+ * @tparam Key       type of key, must be LessThanComparable (operator<)
+ * @tparam Allocator allocator the node memory is taken from; it is rebound
+ * to an internal storage type
  */
-template <typename Key> class SkipList {
+template <typename Key, typename Allocator = std::allocator<Key>>
+class SkipList {
   private:
     /**
-     * @brief Node of the skip list.
+     * @brief Node of the skip list, followed in memory by its tower.
      */
     struct Node {
-        const Key key;            ///< Stored key (immutable)
-        std::vector<Node *> next; ///< Pointers to next nodes at each level
+        const Key key;        ///< Stored key (immutable)
+        Node **next;          ///< Pointers to next nodes at each level
+        int height;           ///< Number of levels of the tower
+        bool deleted = false; ///< Tombstone set by lazy erase
 
-        explicit Node(const Key &k, int level) : key(k), next(level, nullptr) {}
+        Node(const Key &k, int level, Node **tower)
+            : key(k), next(tower), height(level) {
+            std::fill_n(next, level, nullptr);
+        }
     };
 
+    /**
+     * @brief Allocation unit: a node with a tower of h levels takes
+     * unitsFor(h) consecutive units.
+     */
+    struct alignas(Node) Unit {
+        unsigned char bytes[alignof(Node)];
+    };
+
+    using UnitAllocator =
+        typename std::allocator_traits<Allocator>::template rebind_alloc<Unit>;
+    using UnitTraits = std::allocator_traits<UnitAllocator>;
+
+    /**
+     * @brief Skips tombstoned nodes along level 0.
+     */
+    static Node *firstLive(Node *node) {
+        while (node && node->deleted) {
+            node = node->next[0];
+        }
+        return node;
+    }
+
   public:
     /**
      * @brief Forward iterator providing read‑only access to keys.
@@ -51,7 +198,7 @@ template <typename Key> class SkipList {
 
         Iterator &operator++() {
             assert(node_);
-            node_ = node_->next[0];
+            node_ = firstLive(node_->next[0]);
             return *this;
         }
         Iterator operator++(int) {
@@ -72,6 +219,22 @@ template <typename Key> class SkipList {
         friend class SkipList;
     };
 
+    /**
+     * @brief Saved search position for a sequence of ascending lookups.
+     *
+     * Holds the predecessors found by the last seek() at every level. A
+     * finger stays valid while keys are only inserted into the list; erasing
+     * a key invalidates all fingers of the list.
+     */
+    class Finger {
+      public:
+        Finger() = default;
+
+      private:
+        std::vector<Node *> preds_;
+        friend class SkipList;
+    };
+
     // ---------- Constructors / Destructor / Assignment ----------
 
     /**
@@ -81,8 +244,17 @@ template <typename Key> class SkipList {
      * level (0 < p < 1)
      * @param maxAllowedLevel  Maximum level a node can reach (prevents infinite
      * growth)
+     * @param mode             Random heights, or heights hashed from the key
+     * (requires std::hash<Key>). Hashed heights make the structure a function
+     * of the key set alone, whatever the insertion order, and inserts never
+     * touch the generator state.
+     * @param alloc            Allocator for the nodes
+     * @throws std::invalid_argument if @p mode is LevelMode::Hashed and Key
+     * has no std::hash.
      */
-    explicit SkipList(double probability = 0.5, int maxAllowedLevel = 32);
+    explicit SkipList(double probability = 0.5, int maxAllowedLevel = 32,
+                      LevelMode mode = LevelMode::Random,
+                      const Allocator &alloc = Allocator());
 
     /**
      * @brief Destructor – frees all allocated nodes.
@@ -116,8 +288,24 @@ template <typename Key> class SkipList {
      * If the key already exists, the list remains unchanged.
      *
      * @param key The key to insert.
+     * @return Iterator to the key in the list and true if it was inserted,
+     * false if it was already present.
+     */
+    std::pair<Iterator, bool> insert(const Key &key);
+
+    /**
+     * @brief Inserts an ascending sequence of keys.
+     *
+     * The predecessors found for one key are kept as a finger for the next,
+     * so each insertion only searches from the highest level whose finger
+     * lies before the new key instead of descending from the head. Keys
+     * already present (and repeated keys in the input) are skipped.
+     *
+     * @param first, last Range of keys sorted in ascending order.
+     * @return Number of keys actually inserted.
      */
-    void insert(const Key &key);
+    template <typename InputIt>
+    std::size_t insertSorted(InputIt first, InputIt last);
 
     /**
      * @brief Removes a key from the skip list.
@@ -128,6 +316,94 @@ template <typename Key> class SkipList {
      */
     bool erase(const Key &key);
 
+    /**
+     * @brief Removes the key at @p pos.
+     *
+     * With lazy erase the node is only marked, which takes O(1) and keeps
+     * iterators to other keys valid; otherwise the key is looked up again.
+     *
+     * @return false if @p pos is end() or its key is already erased.
+     */
+    bool erase(Iterator pos);
+
+    /**
+     * @brief Removes every key less than @p bound in one pass.
+     *
+     * The predecessors of @p bound are found once, the head is linked past
+     * them at every level, and the cut off prefix is then freed along level
+     * 0, so removing k keys costs O(log n + k). @p visit is called as
+     * visit(const Key &) for each removed key in ascending order and must
+     * not access the list.
+     *
+     * @return Number of keys removed.
+     */
+    template <typename Visitor>
+    std::size_t eraseBelow(const Key &bound, Visitor visit);
+
+    /**
+     * @brief Moves every node of @p tail to the end of this list.
+     *
+     * All keys of @p tail must be greater than the keys of this list. The
+     * nodes are relinked, not copied: the last node of each level is found
+     * in expected O(log n) and pointed at the first node of @p tail on the
+     * same level, so lists built in parallel over disjoint key ranges are
+     * stitched together in time independent of their sizes. @p tail must
+     * use an equal allocator and fit under the level cap of this list; it
+     * is left empty.
+     */
+    void append(SkipList &&tail);
+
+    /**
+     * @brief Returns about @p count keys spread evenly over the list, in
+     * ascending order.
+     *
+     * The keys are read from the lowest level, counted from the top, that
+     * holds at least @p count nodes, so sampling costs expected
+     * O(count / p) instead of a walk over the whole list. They are meant as
+     * splitters to cut the list into ranges of similar sizes.
+     */
+    std::vector<Key> sampleKeys(std::size_t count) const;
+
+    /**
+     * @brief Enables or disables lazy erase.
+     *
+     * In lazy mode erase() only marks the node as deleted: lookups and
+     * iteration skip it, and a later insert of the same key revives it.
+     * Dead nodes are unlinked in batches by purge(), which also runs
+     * automatically once they outnumber the live keys. Disabling lazy mode
+     * purges immediately.
+     *
+     * @param enabled true to defer the physical removal of erased nodes.
+     */
+    void setLazyErase(bool enabled);
+
+    /**
+     * @brief Unlinks and frees every node marked deleted by lazy erase.
+     *
+     * Runs of dead nodes are removed at every level in one pass over level
+     * 0, then empty top levels are dropped.
+     *
+     * @return Number of nodes freed.
+     */
+    std::size_t purge();
+
+    /**
+     * @brief Empties the list without returning any node to the allocator.
+     *
+     * For allocators that release their memory in bulk, such as an arena
+     * about to be dropped as a whole: walking the nodes to free them one by
+     * one would only touch memory that is discarded anyway. Keys are not
+     * destroyed, so they must be trivially destructible.
+     */
+    void abandon() {
+        static_assert(std::is_trivially_destructible_v<Key>,
+                      "abandon() would leak the keys");
+        head_ = nullptr;
+        maxLevel_ = 1;
+        size_ = 0;
+        dead_ = 0;
+    }
+
     /**
      * @brief Checks whether a key is present in the skip list.
      *
@@ -137,23 +413,159 @@ template <typename Key> class SkipList {
      */
     bool contains(const Key &key) const;
 
+    /**
+     * @brief Finds a key in the skip list.
+     *
+     * @param key The key to search for.
+     * @return Iterator to the key, or end() if it is not present.
+     */
+    Iterator find(const Key &key) const;
+
+    /**
+     * @brief Returns an iterator to the first key not less than @p key.
+     *
+     * @param key The lower bound to search for.
+     * @return Iterator to the found key, or end() if every key is less.
+     */
+    Iterator lower_bound(const Key &key) const;
+
+    /**
+     * @brief Calls visit(const Key &) in ascending order on the keys in
+     * [lo, hi) satisfying @p pred.
+     *
+     * The keys are gathered kScanBatch at a time (copied if trivially
+     * copyable) and @p pred is evaluated over a whole batch before any key
+     * is delivered, see skip_list_detail::matchMask(). With a simple
+     * predicate such as KeyFilter, a key that does not match costs a few
+     * instructions instead of an iterator step and a branch.
+     *
+     * @return Number of matching keys.
+     */
+    template <typename Pred, typename Visitor>
+    std::size_t scanIf(const Key &lo, const Key &hi, Pred pred,
+                       Visitor visit) const;
+
+    /**
+     * @brief Copies the keys in [lo, hi) in ascending order into @p out,
+     * stopping when it is full.
+     *
+     * @return Number of keys written.
+     */
+    std::size_t exportRange(const Key &lo, const Key &hi,
+                            std::span<Key> out) const {
+        return exportChunked(
+            lo, hi, out.size(),
+            [out](std::size_t i, const Key &key) { out[i] = key; },
+            [](std::size_t) { return false; });
+    }
+
+    /**
+     * @brief Copies the keys in [lo, hi) in ascending order into @p buffer
+     * chunk after chunk, handing each chunk to sink(std::span<const Key>).
+     *
+     * Every chunk but the last fills the whole buffer.
+     *
+     * @return Number of keys exported.
+     */
+    template <typename Sink>
+    std::size_t exportChunks(const Key &lo, const Key &hi,
+                             std::span<Key> buffer, Sink sink) const {
+        return exportChunked(
+            lo, hi, buffer.size(),
+            [buffer](std::size_t i, const Key &key) { buffer[i] = key; },
+            [&](std::size_t n) {
+                sink(std::span<const Key>(buffer.data(), n));
+                return true;
+            });
+    }
+
+    /**
+     * @brief Core of the range exports, for callers writing their own
+     * columns.
+     *
+     * Walks level 0 over [lo, hi) and calls store(i, key) with the index i
+     * of the key in the current chunk of @p chunk keys, then flush(n) after
+     * each chunk of n keys; the last chunk may be shorter and is flushed
+     * only if not empty. The export stops early when flush returns false.
+     * Both callables are inlined, and the walk prefetches nodes a few links
+     * ahead through the upper levels.
+     *
+     * @return Number of keys stored.
+     */
+    template <typename Store, typename Flush>
+    std::size_t exportChunked(const Key &lo, const Key &hi, std::size_t chunk,
+                              Store store, Flush flush) const;
+
+    /**
+     * @brief Creates a finger positioned before the first key.
+     */
+    Finger finger() const { return Finger(); }
+
+    /**
+     * @brief Finger search: lower_bound() starting from a saved position.
+     *
+     * Instead of descending from the head, the search climbs only as high
+     * as the finger needs to move, so a step over d keys costs expected
+     * O(log d). Successive calls on one finger must use non‑decreasing keys.
+     *
+     * @param finger Position of the previous seek, updated in place.
+     * @param key    The lower bound to search for.
+     * @return Iterator to the first key not less than @p key, or end().
+     */
+    Iterator seek(Finger &finger, const Key &key) const;
+
+    /**
+     * @brief Returns the number of keys stored in the list.
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * @brief Checks whether the list holds no keys.
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Attaches a sink notified about every change of the list.
+     *
+     * @param sink The sink to notify, or nullptr to detach. The sink must
+     * outlive the attachment.
+     */
+    void setChangeSink(ChangeSink<Key> *sink) { changes_ = sink; }
+
+    /**
+     * @brief Returns the currently attached change sink, or nullptr.
+     */
+    ChangeSink<Key> *changeSink() const { return changes_; }
+
     // ---------- Print by levels ----------
 
     /**
      * @brief Prints the entire skip list level by level.
      *
      * Each level from the highest down to 0 is printed as a space‑separated
-     * list of keys.
+     * list of keys. Lazily erased keys awaiting purge() are shown in
+     * parentheses.
      * @param os Output stream (default: std::cout)
      */
     void printByLevels(std::ostream &os = std::cout) const;
 
+    /**
+     * @brief Checks whether two lists have the same physical layout.
+     *
+     * Compares the nodes of both lists along level 0: keys, tower heights
+     * and tombstones. Lists built in LevelMode::Hashed with the same
+     * probability and level cap from the same keys always compare equal.
+     */
+    bool sameStructure(const SkipList &other) const;
+
     // ---------- Iterators ----------
 
     /**
      * @brief Returns an iterator to the first element (level 0).
      */
-    Iterator begin() const { return Iterator(head_->next[0]); }
+    Iterator begin() const {
+        return Iterator(head_ ? firstLive(head_->next[0]) : nullptr);
+    }
 
     /**
      * @brief Returns an iterator past the last element.
@@ -161,111 +573,220 @@ template <typename Key> class SkipList {
     Iterator end() const { return Iterator(nullptr); }
 
   private:
-    Node *head_;          ///< Dummy head node (key is default constructed)
-    int maxLevel_;        ///< Current number of levels (height of the head)
-    int maxAllowedLevel_; ///< Level cap, set at construction
-    double probability_;  ///< Probability p for level promotion
+    Node *head_ = nullptr; ///< Dummy head node, allocated on first insert
+    int maxLevel_;         ///< Current number of levels (height of the head)
+    int maxAllowedLevel_;  ///< Level cap, set at construction
+    double probability_;   ///< Probability p for level promotion
+    std::size_t size_ = 0; ///< Number of stored keys
+    std::size_t dead_ = 0; ///< Tombstoned nodes awaiting purge()
+    bool lazyErase_ = false;
+    bool hashedLevels_ = false; ///< LevelMode::Hashed
+
+    ChangeSink<Key> *changes_ = nullptr; ///< Optional mutation observer
 
-    mutable std::mt19937 rng_; ///< Random number generator
-    mutable std::uniform_real_distribution<double>
-        dist_; ///< Uniform [0,1) distribution
+    mutable std::uint64_t rngState_; ///< xorshift64* state, never zero
+    [[no_unique_address]] UnitAllocator alloc_;
+
+    /**
+     * @brief Uniform double in [0, 1) from the per-list generator.
+     */
+    double nextUniform() const;
+
+    static constexpr bool kHashable =
+        std::is_invocable_v<std::hash<Key>, const Key &>;
 
     /**
      * @brief Generates a random level for a new node.
      *
      * Uses probability_ and the current max level to decide how high the node
      * should go. The result is always between 1 and maxAllowedLevel_
-     * (inclusive).
+     * (inclusive). In hashed mode the level depends only on @p key and is not
+     * limited by the current max level.
      *
      * @return Randomly determined level.
      */
-    int randomLevel() const;
+    int randomLevel(const Key &key) const;
+
+    /**
+     * @brief Returns the head node, allocating it on first use.
+     *
+     * The head tower is allocated for maxAllowedLevel_ levels at once, so
+     * growing the list only raises maxLevel_.
+     */
+    Node *ensureHead();
+
+    static std::size_t unitsFor(int level) {
+        return (sizeof(Node) + level * sizeof(Node *) + sizeof(Unit) - 1) /
+               sizeof(Unit);
+    }
+
+    Node *allocateNode(const Key &key, int level);
+    void freeNode(Node *node);
+
+    /**
+     * @brief Frees every node including the head.
+     */
+    void destroyNodes();
 
     /**
-     * @brief Restores the object to a valid empty state.
+     * @brief Moves the predecessors in @p update forward to those of
+     * @p key.
      *
-     * Intended only for use on moved‑from objects. Creates a new head node if
-     * needed.
+     * Every update[i] must be the predecessor at level i of one earlier key.
+     * The search climbs from level 0 while the saved predecessor of the next
+     * level can still move forward, then descends.
+     *
+     * @return The predecessor of @p key at level 0.
+     */
+    Node *advanceFinger(std::vector<Node *> &update, const Key &key) const;
+
+    /**
+     * @brief Tombstones a live node in lazy erase mode.
      */
-    void resetToEmpty();
+    void markDead(Node *node);
+
+    /**
+     * @brief Clears the tombstone of a lazily erased node.
+     */
+    void revive(Node *node);
+
+    /// Dead nodes tolerated beyond the live count before an automatic purge
+    static constexpr std::size_t kMinPurge = 64;
 };
 
 // ---------- Method implementation ----------
 
-template <typename Key>
-SkipList<Key>::SkipList(double probability, int maxAllowedLevel)
-    : probability_(probability), maxAllowedLevel_(maxAllowedLevel),
-      maxLevel_(1), dist_(0.0, 1.0) {
-    std::random_device rd;
-    rng_.seed(rd());
-    head_ = new Node(Key(), maxLevel_);
+template <typename Key, typename Allocator>
+SkipList<Key, Allocator>::SkipList(double probability, int maxAllowedLevel,
+                                   LevelMode mode, const Allocator &alloc)
+    : maxLevel_(1), maxAllowedLevel_(maxAllowedLevel),
+      probability_(probability), hashedLevels_(mode == LevelMode::Hashed),
+      rngState_(skip_list_detail::nextSeed()), alloc_(alloc) {
+    if (!kHashable && hashedLevels_) {
+        throw std::invalid_argument("LevelMode::Hashed needs std::hash<Key>");
+    }
 }
 
-template <typename Key> SkipList<Key>::~SkipList() {
-    if (!head_)
-        return;
-    Node *cur = head_->next[0];
-    while (cur) {
-        Node *next = cur->next[0];
-        delete cur;
-        cur = next;
-    }
-    delete head_;
+template <typename Key, typename Allocator>
+SkipList<Key, Allocator>::~SkipList() {
+    destroyNodes();
 }
 
-template <typename Key>
-SkipList<Key>::SkipList(SkipList &&other) noexcept
+template <typename Key, typename Allocator>
+SkipList<Key, Allocator>::SkipList(SkipList &&other) noexcept
     : head_(std::exchange(other.head_, nullptr)),
       maxLevel_(std::exchange(other.maxLevel_, 1)),
       maxAllowedLevel_(other.maxAllowedLevel_),
-      probability_(other.probability_), rng_(std::move(other.rng_)),
-      dist_(other.dist_) {
-    if (!head_) {
-        head_ = new Node(Key(), maxLevel_);
-    }
-    other.resetToEmpty();
-}
+      probability_(other.probability_),
+      size_(std::exchange(other.size_, 0)),
+      dead_(std::exchange(other.dead_, 0)), lazyErase_(other.lazyErase_),
+      hashedLevels_(other.hashedLevels_),
+      changes_(std::exchange(other.changes_, nullptr)),
+      rngState_(other.rngState_), alloc_(other.alloc_) {}
 
-template <typename Key>
-auto SkipList<Key>::operator=(SkipList &&other) noexcept -> SkipList & {
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::operator=(SkipList &&other) noexcept
+    -> SkipList & {
     if (this != &other) {
-        if (head_) {
-            Node *cur = head_->next[0];
-            while (cur) {
-                Node *next = cur->next[0];
-                delete cur;
-                cur = next;
-            }
-            delete head_;
-        }
+        destroyNodes();
 
         head_ = std::exchange(other.head_, nullptr);
         maxLevel_ = std::exchange(other.maxLevel_, 1);
         maxAllowedLevel_ = other.maxAllowedLevel_;
         probability_ = other.probability_;
-        rng_ = std::move(other.rng_);
-        dist_ = other.dist_;
-
-        if (!head_) {
-            head_ = new Node(Key(), maxLevel_);
-        }
-        other.resetToEmpty();
+        size_ = std::exchange(other.size_, 0);
+        dead_ = std::exchange(other.dead_, 0);
+        lazyErase_ = other.lazyErase_;
+        hashedLevels_ = other.hashedLevels_;
+        changes_ = std::exchange(other.changes_, nullptr);
+        rngState_ = other.rngState_;
+        alloc_ = other.alloc_;
     }
     return *this;
 }
 
-template <typename Key> int SkipList<Key>::randomLevel() const {
+template <typename Key, typename Allocator>
+double SkipList<Key, Allocator>::nextUniform() const {
+    rngState_ ^= rngState_ >> 12;
+    rngState_ ^= rngState_ << 25;
+    rngState_ ^= rngState_ >> 27;
+    return skip_list_detail::toUnit(rngState_ * 0x2545F4914F6CDD1Dull);
+}
+
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::ensureHead() -> Node * {
+    if (!head_) {
+        head_ = allocateNode(Key(), maxAllowedLevel_);
+    }
+    return head_;
+}
+
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::allocateNode(const Key &key, int level)
+    -> Node * {
+    Unit *memory = UnitTraits::allocate(alloc_, unitsFor(level));
+    Node **tower = reinterpret_cast<Node **>(
+        reinterpret_cast<unsigned char *>(memory) + sizeof(Node));
+    try {
+        return ::new (static_cast<void *>(memory)) Node(key, level, tower);
+    } catch (...) {
+        UnitTraits::deallocate(alloc_, memory, unitsFor(level));
+        throw;
+    }
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::freeNode(Node *node) {
+    const int level = node->height;
+    node->~Node();
+    UnitTraits::deallocate(alloc_, reinterpret_cast<Unit *>(node),
+                           unitsFor(level));
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::destroyNodes() {
+    if (!head_) {
+        return;
+    }
+    Node *cur = head_->next[0];
+    while (cur) {
+        Node *next = cur->next[0];
+        freeNode(cur);
+        cur = next;
+    }
+    freeNode(head_);
+    head_ = nullptr;
+}
+
+template <typename Key, typename Allocator>
+int SkipList<Key, Allocator>::randomLevel(
+    [[maybe_unused]] const Key &key) const {
     int level = 1;
-    while (dist_(rng_) < probability_ && level < maxAllowedLevel_ &&
+    if constexpr (kHashable) {
+        if (hashedLevels_) {
+            // Successive splitmix64 outputs of the key hash act as the coin
+            using skip_list_detail::splitmix64;
+            using skip_list_detail::toUnit;
+            std::uint64_t x = std::hash<Key>{}(key);
+            while (level < maxAllowedLevel_ &&
+                   toUnit(splitmix64(x)) < probability_) {
+                ++level;
+            }
+            return level;
+        }
+    }
+    while (nextUniform() < probability_ && level < maxAllowedLevel_ &&
            level < maxLevel_ + 1) {
         ++level;
     }
     return level;
 }
 
-template <typename Key> void SkipList<Key>::insert(const Key &key) {
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::insert(const Key &key)
+    -> std::pair<Iterator, bool> {
     std::vector<Node *> update(maxLevel_, nullptr);
-    Node *cur = head_;
+    Node *cur = ensureHead();
 
     for (int i = maxLevel_ - 1; i >= 0; --i) {
         while (cur->next[i] && cur->next[i]->key < key) {
@@ -276,29 +797,139 @@ template <typename Key> void SkipList<Key>::insert(const Key &key) {
     cur = cur->next[0];
 
     if (cur && cur->key == key) {
-        return;
+        if (!cur->deleted) {
+            return {Iterator(cur), false};
+        }
+        revive(cur);
+        return {Iterator(cur), true};
     }
 
-    int newLevel = randomLevel();
+    int newLevel = randomLevel(key);
+    Node *newNode = allocateNode(key, newLevel);
 
     if (newLevel > maxLevel_) {
-        head_->next.resize(newLevel, nullptr);
-        update.resize(newLevel, nullptr);
-        for (int i = maxLevel_; i < newLevel; ++i) {
-            update[i] = head_;
-        }
+        update.resize(newLevel, head_);
         maxLevel_ = newLevel;
     }
 
-    auto *newNode = new Node(key, newLevel);
-
     for (int i = 0; i < newLevel; ++i) {
         newNode->next[i] = update[i]->next[i];
         update[i]->next[i] = newNode;
     }
+    ++size_;
+    if (changes_) {
+        changes_->onInsert(key);
+    }
+    return {Iterator(newNode), true};
+}
+
+template <typename Key, typename Allocator>
+template <typename InputIt>
+std::size_t SkipList<Key, Allocator>::insertSorted(InputIt first,
+                                                   InputIt last) {
+    if (first == last) {
+        return 0;
+    }
+    std::vector<Node *> update(maxLevel_, ensureHead());
+    std::size_t inserted = 0;
+
+    for (; first != last; ++first) {
+        const Key &key = *first;
+        Node *cur = advanceFinger(update, key);
+
+        // The finger may sit on a repeated input key itself
+        Node *found = cur->next[0];
+        if (cur != head_ && !(cur->key < key)) {
+            continue;
+        }
+        if (found && found->key == key) {
+            if (found->deleted) {
+                revive(found);
+                ++inserted;
+            }
+            continue;
+        }
+
+        int newLevel = randomLevel(key);
+        Node *newNode = allocateNode(key, newLevel);
+        if (newLevel > maxLevel_) {
+            update.resize(newLevel, head_);
+            maxLevel_ = newLevel;
+        }
+
+        for (int i = 0; i < newLevel; ++i) {
+            newNode->next[i] = update[i]->next[i];
+            update[i]->next[i] = newNode;
+            update[i] = newNode;
+        }
+        ++size_;
+        ++inserted;
+        if (changes_) {
+            changes_->onInsert(key);
+        }
+    }
+    return inserted;
+}
+
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::advanceFinger(std::vector<Node *> &update,
+                                  const Key &key) const -> Node * {
+    auto further = [this](Node *a, Node *b) {
+        if (a == head_) {
+            return b;
+        }
+        return b != head_ && a->key < b->key ? b : a;
+    };
+
+    // update[i]->next[i] never precedes update[i - 1]->next[i - 1], so
+    // climbing stops at the first level that cannot move forward
+    int top = 0;
+    while (top + 1 < maxLevel_) {
+        Node *succ = update[top + 1]->next[top + 1];
+        if (!succ || !(succ->key < key)) {
+            break;
+        }
+        ++top;
+    }
+
+    Node *cur = update[top];
+    for (int i = top; i >= 0; --i) {
+        cur = further(cur, update[i]);
+        while (cur->next[i] && cur->next[i]->key < key) {
+            cur = cur->next[i];
+        }
+        update[i] = cur;
+    }
+    return cur;
+}
+
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::seek(Finger &finger, const Key &key) const
+    -> Iterator {
+    if (!head_) {
+        return end();
+    }
+    if (finger.preds_.size() < static_cast<std::size_t>(maxLevel_)) {
+        finger.preds_.resize(maxLevel_, head_);
+    }
+    Node *cur = advanceFinger(finger.preds_, key);
+    return Iterator(firstLive(cur->next[0]));
 }
 
-template <typename Key> bool SkipList<Key>::erase(const Key &key) {
+template <typename Key, typename Allocator>
+bool SkipList<Key, Allocator>::erase(const Key &key) {
+    if (lazyErase_) {
+        Node *node = find(key).node_;
+        if (!node) {
+            return false;
+        }
+        markDead(node);
+        return true;
+    }
+    if (!head_) {
+        return false;
+    }
+
     std::vector<Node *> update(maxLevel_, nullptr);
     Node *cur = head_;
 
@@ -319,17 +950,87 @@ template <typename Key> bool SkipList<Key>::erase(const Key &key) {
             update[i]->next[i] = cur->next[i];
         }
     }
-    delete cur;
+    if (changes_) {
+        changes_->onErase(cur->key);
+    }
+    freeNode(cur);
+    --size_;
 
     while (maxLevel_ > 1 && head_->next[maxLevel_ - 1] == nullptr) {
         --maxLevel_;
-        head_->next.pop_back();
     }
 
     return true;
 }
 
-template <typename Key> bool SkipList<Key>::contains(const Key &key) const {
+template <typename Key, typename Allocator>
+bool SkipList<Key, Allocator>::erase(Iterator pos) {
+    if (!pos.node_ || pos.node_->deleted) {
+        return false;
+    }
+    if (!lazyErase_) {
+        Key key = *pos;
+        return erase(key);
+    }
+    markDead(pos.node_);
+    return true;
+}
+
+template <typename Key, typename Allocator>
+template <typename Visitor>
+std::size_t SkipList<Key, Allocator>::eraseBelow(const Key &bound,
+                                                 Visitor visit) {
+    if (!head_) {
+        return 0;
+    }
+    std::vector<Node *> last(maxLevel_, nullptr);
+    Node *cur = head_;
+    for (int i = maxLevel_ - 1; i >= 0; --i) {
+        while (cur->next[i] && cur->next[i]->key < bound) {
+            cur = cur->next[i];
+        }
+        last[i] = cur;
+    }
+    if (last[0] == head_) {
+        return 0;
+    }
+
+    Node *node = head_->next[0];
+    Node *stop = last[0]->next[0];
+    for (int i = 0; i < maxLevel_; ++i) {
+        if (last[i] != head_) {
+            head_->next[i] = last[i]->next[i];
+        }
+    }
+
+    std::size_t removed = 0;
+    while (node != stop) {
+        Node *next = node->next[0];
+        if (node->deleted) {
+            --dead_;
+        } else {
+            if (changes_) {
+                changes_->onErase(node->key);
+            }
+            visit(node->key);
+            ++removed;
+        }
+        freeNode(node);
+        node = next;
+    }
+    size_ -= removed;
+
+    while (maxLevel_ > 1 && head_->next[maxLevel_ - 1] == nullptr) {
+        --maxLevel_;
+    }
+    return removed;
+}
+
+template <typename Key, typename Allocator>
+bool SkipList<Key, Allocator>::contains(const Key &key) const {
+    if (!head_) {
+        return false;
+    }
     Node *cur = head_;
     for (int i = maxLevel_ - 1; i >= 0; --i) {
         while (cur->next[i] && cur->next[i]->key < key) {
@@ -337,13 +1038,249 @@ template <typename Key> bool SkipList<Key>::contains(const Key &key) const {
         }
     }
     cur = cur->next[0];
-    return cur && cur->key == key;
+    return cur && cur->key == key && !cur->deleted;
+}
+
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::find(const Key &key) const -> Iterator {
+    Iterator it = lower_bound(key);
+    return it != end() && *it == key ? it : end();
 }
 
-template <typename Key>
-void SkipList<Key>::printByLevels(std::ostream &os) const {
+template <typename Key, typename Allocator>
+auto SkipList<Key, Allocator>::lower_bound(const Key &key) const -> Iterator {
     if (!head_) {
-        os << "SkipList (empty - moved from)\n";
+        return end();
+    }
+    Node *cur = head_;
+    for (int i = maxLevel_ - 1; i >= 0; --i) {
+        while (cur->next[i] && cur->next[i]->key < key) {
+            cur = cur->next[i];
+        }
+    }
+    return Iterator(firstLive(cur->next[0]));
+}
+
+template <typename Key, typename Allocator>
+template <typename Pred, typename Visitor>
+std::size_t SkipList<Key, Allocator>::scanIf(const Key &lo, const Key &hi,
+                                             Pred pred, Visitor visit) const {
+    using skip_list_detail::kScanBatch;
+    constexpr bool kCopy = std::is_trivially_copyable_v<Key>;
+    using Item = std::conditional_t<kCopy, Key, const Key *>;
+    auto key = [](const Item &item) -> const Key & {
+        if constexpr (kCopy) {
+            return item;
+        } else {
+            return *item;
+        }
+    };
+    auto test = [&](const Item &item) { return pred(key(item)); };
+
+    Item batch[kScanBatch];
+    std::size_t matches = 0;
+    Node *node = lower_bound(lo).node_;
+    while (node && node->key < hi) {
+        std::size_t n = 0;
+        for (; n < kScanBatch && node && node->key < hi;
+             node = firstLive(node->next[0])) {
+            if constexpr (kCopy) {
+                batch[n++] = node->key;
+            } else {
+                batch[n++] = &node->key;
+            }
+        }
+        std::uint64_t mask = skip_list_detail::matchMask(batch, n, test);
+        matches += std::popcount(mask);
+        for (; mask; mask &= mask - 1) {
+            visit(key(batch[std::countr_zero(mask)]));
+        }
+    }
+    return matches;
+}
+
+template <typename Key, typename Allocator>
+template <typename Store, typename Flush>
+std::size_t SkipList<Key, Allocator>::exportChunked(const Key &lo,
+                                                    const Key &hi,
+                                                    std::size_t chunk,
+                                                    Store store,
+                                                    Flush flush) const {
+    if (chunk == 0) {
+        return 0;
+    }
+    std::size_t total = 0;
+    std::size_t filled = 0;
+    for (Node *node = lower_bound(lo).node_; node && node->key < hi;
+         node = firstLive(node->next[0])) {
+        // A link of level 1 or 2 leads 2-4 nodes ahead on average: far
+        // enough to hide the miss, near enough to be used soon
+        skip_list_detail::prefetch(node->next[std::min(node->height, 3) - 1]);
+        store(filled, node->key);
+        if (++filled == chunk) {
+            total += chunk;
+            filled = 0;
+            if (!flush(chunk)) {
+                return total;
+            }
+        }
+    }
+    if (filled > 0) {
+        total += filled;
+        flush(filled);
+    }
+    return total;
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::append(SkipList &&tail) {
+    if (this == &tail || !tail.head_) {
+        return;
+    }
+    assert(alloc_ == tail.alloc_);
+    assert(tail.maxLevel_ <= maxAllowedLevel_);
+    Node *head = ensureHead();
+    Node *cur = head;
+    for (int i = std::max(maxLevel_, tail.maxLevel_) - 1; i >= 0; --i) {
+        while (cur->next[i]) {
+            cur = cur->next[i];
+        }
+        assert(cur == head || !tail.head_->next[0] ||
+               cur->key < tail.head_->next[0]->key);
+        if (i < tail.maxLevel_) {
+            cur->next[i] = tail.head_->next[i];
+        }
+    }
+    if (changes_) {
+        for (Node *node = tail.head_->next[0]; node; node = node->next[0]) {
+            if (!node->deleted) {
+                changes_->onInsert(node->key);
+            }
+        }
+    }
+    maxLevel_ = std::max(maxLevel_, tail.maxLevel_);
+    size_ += std::exchange(tail.size_, 0);
+    dead_ += std::exchange(tail.dead_, 0);
+    std::fill_n(tail.head_->next, tail.maxLevel_, nullptr);
+    tail.maxLevel_ = 1;
+}
+
+template <typename Key, typename Allocator>
+std::vector<Key> SkipList<Key, Allocator>::sampleKeys(std::size_t count) const {
+    std::vector<Key> keys;
+    if (!head_ || count == 0) {
+        return keys;
+    }
+    int level = maxLevel_ - 1;
+    std::size_t nodes = 0;
+    for (;; --level) {
+        nodes = 0;
+        for (Node *cur = head_->next[level]; cur; cur = cur->next[level]) {
+            ++nodes;
+        }
+        if (nodes >= count || level == 0) {
+            break;
+        }
+    }
+    // Every stride-th node of the level, stride taken in fixed point so
+    // the picks spread over the whole level
+    keys.reserve(std::min(count, nodes));
+    std::size_t index = 0;
+    std::size_t next = 0;
+    for (Node *cur = head_->next[level]; cur && keys.size() < count;
+         cur = cur->next[level], ++index) {
+        if (index == next) {
+            keys.push_back(cur->key);
+            next = std::max(index + 1, keys.size() * nodes / count);
+        }
+    }
+    return keys;
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::setLazyErase(bool enabled) {
+    lazyErase_ = enabled;
+    if (!enabled) {
+        purge();
+    }
+}
+
+template <typename Key, typename Allocator>
+std::size_t SkipList<Key, Allocator>::purge() {
+    if (dead_ == 0) {
+        return 0;
+    }
+
+    // update[i] is the last live node seen so far at level i
+    std::vector<Node *> update(maxLevel_, head_);
+    std::size_t freed = 0;
+    Node *cur = head_->next[0];
+    while (cur) {
+        Node *next = cur->next[0];
+        int level = cur->height;
+        if (cur->deleted) {
+            for (int i = 0; i < level; ++i) {
+                update[i]->next[i] = cur->next[i];
+            }
+            freeNode(cur);
+            ++freed;
+        } else {
+            for (int i = 0; i < level; ++i) {
+                update[i] = cur;
+            }
+        }
+        cur = next;
+    }
+    dead_ = 0;
+
+    while (maxLevel_ > 1 && head_->next[maxLevel_ - 1] == nullptr) {
+        --maxLevel_;
+    }
+    return freed;
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::markDead(Node *node) {
+    node->deleted = true;
+    --size_;
+    ++dead_;
+    if (changes_) {
+        changes_->onErase(node->key);
+    }
+    if (dead_ > size_ + kMinPurge) {
+        purge();
+    }
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::revive(Node *node) {
+    node->deleted = false;
+    ++size_;
+    --dead_;
+    if (changes_) {
+        changes_->onInsert(node->key);
+    }
+}
+
+template <typename Key, typename Allocator>
+bool SkipList<Key, Allocator>::sameStructure(const SkipList &other) const {
+    Node *a = head_ ? head_->next[0] : nullptr;
+    Node *b = other.head_ ? other.head_->next[0] : nullptr;
+    while (a && b) {
+        if (a->height != b->height || a->deleted != b->deleted ||
+            a->key < b->key || b->key < a->key) {
+            return false;
+        }
+        a = a->next[0];
+        b = b->next[0];
+    }
+    return a == b;
+}
+
+template <typename Key, typename Allocator>
+void SkipList<Key, Allocator>::printByLevels(std::ostream &os) const {
+    if (!head_) {
+        os << "SkipList (empty)\n";
         return;
     }
     os << "SkipList (levels = " << maxLevel_ << ", p = " << probability_
@@ -352,7 +1289,11 @@ void SkipList<Key>::printByLevels(std::ostream &os) const {
         os << "Level " << i << ": ";
         Node *node = head_->next[i];
         while (node) {
-            os << node->key << ' ';
+            if (node->deleted) {
+                os << '(' << node->key << ") ";
+            } else {
+                os << node->key << ' ';
+            }
             node = node->next[i];
         }
         os << '\n';
@@ -360,10 +1301,4 @@ void SkipList<Key>::printByLevels(std::ostream &os) const {
     os.flush();
 }
 
-template <typename Key> void SkipList<Key>::resetToEmpty() {
-    if (!head_) {
-        head_ = new Node(Key(), maxLevel_);
-    }
-}
-
 #endif // SKIP_LIST_HPP
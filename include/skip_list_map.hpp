@@ -0,0 +1,195 @@
+#ifndef SKIP_LIST_MAP_HPP
+#define SKIP_LIST_MAP_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+
+/**
+ * @brief Key/value pair stored in a SkipListMap.
+ *
+ * Entries are ordered and compared by key only. The value is mutable so it
+ * can be updated in place through the read‑only iterators of the underlying
+ * SkipList without touching the ordering.
+ */
+template <typename Key, typename Value> struct MapEntry {
+    Key key;
+    mutable Value value;
+
+    bool operator<(const MapEntry &other) const { return key < other.key; }
+    bool operator==(const MapEntry &other) const { return key == other.key; }
+};
+
+/**
+ * @brief Ordered map with unique keys built on top of SkipList.
+ *
+ * Every entry is one SkipList node, so all operations keep the expected
+ * O(log n) complexity of the underlying list.
+ *
+ * @tparam Key   type of key, must be LessThanComparable and default
+ * constructible
+ * @tparam Value type of mapped value, must be default constructible
+ */
+template <typename Key, typename Value> class SkipListMap {
+  public:
+    using Entry = MapEntry<Key, Value>;
+    using Iterator = typename SkipList<Entry>::Iterator;
+
+    /**
+     * @brief Constructs an empty map.
+     *
+     * @param probability      Probability p of promoting a node to the next
+     * level (0 < p < 1)
+     * @param maxAllowedLevel  Maximum level a node can reach
+     */
+    explicit SkipListMap(double probability = 0.5, int maxAllowedLevel = 32)
+        : list_(probability, maxAllowedLevel) {}
+
+    /**
+     * @brief Inserts a key/value pair unless the key is already present.
+     *
+     * @return true if the pair was inserted, false if the key existed.
+     */
+    bool insert(const Key &key, const Value &value) {
+        return emplace(key, value).second;
+    }
+
+    /**
+     * @brief Inserts a key/value pair unless the key is already present.
+     *
+     * @return Iterator to the entry for @p key and true if it was inserted,
+     * false if the key existed (its value is left unchanged).
+     */
+    std::pair<Iterator, bool> emplace(const Key &key, const Value &value) {
+        auto result = list_.insert(Entry{key, value});
+        if (result.second) {
+            // A key revived from a lazy erase keeps its old entry
+            result.first->value = value;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Inserts a key/value pair or overwrites the value of an existing
+     * key.
+     *
+     * @return true if a new key was inserted, false if a value was replaced.
+     */
+    bool insertOrAssign(const Key &key, const Value &value) {
+        auto [it, inserted] = list_.insert(Entry{key, value});
+        // A key revived from a lazy erase keeps its old entry as well
+        it->value = value;
+        return inserted;
+    }
+
+    /**
+     * @brief Removes a key and its value.
+     *
+     * @return true if the key was found and removed, false otherwise.
+     */
+    bool erase(const Key &key) { return list_.erase(Entry{key, Value()}); }
+
+    /**
+     * @brief Removes the entry at @p pos; O(1) with lazy erase.
+     */
+    bool erase(Iterator pos) { return list_.erase(pos); }
+
+    /**
+     * @brief Removes every entry whose key is less than @p bound.
+     *
+     * @param visit Called as visit(const Entry &) for each removed entry
+     * @return Number of entries removed.
+     */
+    template <typename Visitor>
+    std::size_t eraseBelow(const Key &bound, Visitor visit) {
+        return list_.eraseBelow(Entry{bound, Value()}, visit);
+    }
+
+    /**
+     * @brief Enables or disables lazy erase, see SkipList::setLazyErase().
+     *
+     * Reinserting an erased key revives its node and stores the new value.
+     */
+    void setLazyErase(bool enabled) { list_.setLazyErase(enabled); }
+
+    /**
+     * @brief Checks whether a key is present in the map.
+     */
+    bool contains(const Key &key) const {
+        return list_.contains(Entry{key, Value()});
+    }
+
+    /**
+     * @brief Finds the entry for a key.
+     *
+     * @return Iterator to the entry, or end() if the key is not present.
+     */
+    Iterator find(const Key &key) const {
+        return list_.find(Entry{key, Value()});
+    }
+
+    /**
+     * @brief Returns an iterator to the first entry whose key is not less
+     * than @p key.
+     */
+    Iterator lower_bound(const Key &key) const {
+        return list_.lower_bound(Entry{key, Value()});
+    }
+
+    /**
+     * @brief Copies the entries with keys in [lo, hi) in key order into
+     * two columns, stopping when the shorter one is full.
+     *
+     * @return Number of entries written.
+     */
+    std::size_t exportRange(const Key &lo, const Key &hi, std::span<Key> keys,
+                            std::span<Value> values) const {
+        return list_.exportChunked(
+            Entry{lo, Value()}, Entry{hi, Value()},
+            std::min(keys.size(), values.size()),
+            [keys, values](std::size_t i, const Entry &entry) {
+                keys[i] = entry.key;
+                values[i] = entry.value;
+            },
+            [](std::size_t) { return false; });
+    }
+
+    /**
+     * @brief Copies the entries with keys in [lo, hi) in key order into
+     * the two columns chunk after chunk, handing each chunk to
+     * sink(std::span<const Key>, std::span<const Value>).
+     *
+     * @return Number of entries exported.
+     */
+    template <typename Sink>
+    std::size_t exportChunks(const Key &lo, const Key &hi,
+                             std::span<Key> keys, std::span<Value> values,
+                             Sink sink) const {
+        return list_.exportChunked(
+            Entry{lo, Value()}, Entry{hi, Value()},
+            std::min(keys.size(), values.size()),
+            [keys, values](std::size_t i, const Entry &entry) {
+                keys[i] = entry.key;
+                values[i] = entry.value;
+            },
+            [&](std::size_t n) {
+                sink(std::span<const Key>(keys.data(), n),
+                     std::span<const Value>(values.data(), n));
+                return true;
+            });
+    }
+
+    std::size_t size() const { return list_.size(); }
+    bool empty() const { return list_.empty(); }
+
+    Iterator begin() const { return list_.begin(); }
+    Iterator end() const { return list_.end(); }
+
+  private:
+    SkipList<Entry> list_; ///< Entries ordered by key
+};
+
+#endif // SKIP_LIST_MAP_HPP
@@ -0,0 +1,442 @@
+#ifndef SKIP_TRIE_HPP
+#define SKIP_TRIE_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Ordered set of 64-bit keys with expected O(log log U) searches
+ * (skip-trie).
+ *
+ * The keys form a skip list truncated to kLevels = log2(64) levels with
+ * promotion probability 1/2, so about one key in 32 reaches the top level.
+ * Those top keys are also indexed by an x-fast trie: one hash table per
+ * prefix length, mapping every prefix of a top key to the smallest and the
+ * largest top key below it. A search binary searches the prefix lengths for
+ * the longest prefix of the key that is present (6 hash lookups), which
+ * yields the closest top key before it, and descends the few levels below
+ * from there in expected O(1) steps each.
+ *
+ * A top key updates the 65 prefix tables on insert() and erase(), but only
+ * one key in 32 is a top key, so updates stay amortized O(log log U) too.
+ * Level 0 is an ordinary sorted list, which iteration follows.
+ */
+class SkipTrie {
+    static constexpr int kLevels = 6; ///< log2 of the key width
+    static constexpr int kTop = kLevels - 1;
+    static constexpr int kBits = 64;
+
+    struct Node;
+
+    /**
+     * @brief Next node of a level with a copy of its key, so a search
+     * compares without loading the nodes it does not move to.
+     */
+    struct Link {
+        Node *node;
+        std::uint64_t key;
+    };
+
+    /**
+     * @brief Key followed in memory by its tower of links.
+     */
+    struct alignas(alignof(Link)) Node {
+        std::uint64_t key;
+        Node *prevTop; ///< Previous top key, only set for top keys
+        int height;
+
+        Link *next() { return reinterpret_cast<Link *>(this + 1); }
+    };
+
+    /**
+     * @brief Smallest and largest top keys sharing a prefix.
+     */
+    struct Range {
+        Node *min;
+        Node *max;
+    };
+
+    /**
+     * @brief Hash table from prefixes to ranges with open addressing.
+     *
+     * A lookup touches one or two adjacent slots instead of following a
+     * bucket chain, which matters since a search probes several tables.
+     */
+    class PrefixTable {
+        struct Slot {
+            std::uint64_t prefix;
+            Range range; ///< range.min is null in an empty slot
+        };
+
+      public:
+        Range *find(std::uint64_t prefix) {
+            if (slots_.empty()) {
+                return nullptr;
+            }
+            for (std::size_t i = home(prefix);; i = (i + 1) & mask()) {
+                Slot &slot = slots_[i];
+                if (!slot.range.min) {
+                    return nullptr;
+                }
+                if (slot.prefix == prefix) {
+                    return &slot.range;
+                }
+            }
+        }
+        const Range *find(std::uint64_t prefix) const {
+            return const_cast<PrefixTable *>(this)->find(prefix);
+        }
+
+        /**
+         * @brief Returns the range of @p prefix, adding @p range for it if
+         * absent.
+         *
+         * @return The stored range and whether it was added.
+         */
+        std::pair<Range *, bool> tryEmplace(std::uint64_t prefix,
+                                            const Range &range) {
+            if (Range *found = find(prefix)) {
+                return {found, false};
+            }
+            if (2 * (size_ + 1) > slots_.size()) {
+                grow();
+            }
+            std::size_t i = home(prefix);
+            while (slots_[i].range.min) {
+                i = (i + 1) & mask();
+            }
+            slots_[i] = {prefix, range};
+            ++size_;
+            return {&slots_[i].range, true};
+        }
+
+        /**
+         * @brief Removes the entry holding @p range, shifting back the
+         * entries of its probe run.
+         */
+        void erase(Range *range) {
+            std::size_t hole = reinterpret_cast<Slot *>(
+                                   reinterpret_cast<char *>(range) -
+                                   offsetof(Slot, range)) -
+                               slots_.data();
+            for (std::size_t i = (hole + 1) & mask(); slots_[i].range.min;
+                 i = (i + 1) & mask()) {
+                // An entry may fill the hole if its home is not in (hole, i]
+                std::size_t dist = (i - home(slots_[i].prefix)) & mask();
+                if (dist >= ((i - hole) & mask())) {
+                    slots_[hole] = slots_[i];
+                    hole = i;
+                }
+            }
+            slots_[hole].range.min = nullptr;
+            --size_;
+        }
+
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+      private:
+        std::size_t mask() const { return slots_.size() - 1; }
+
+        std::size_t home(std::uint64_t prefix) const {
+            std::uint64_t state = prefix;
+            return skip_list_detail::splitmix64(state) & mask();
+        }
+
+        void grow() {
+            std::vector<Slot> old(std::max<std::size_t>(16, 2 * slots_.size()),
+                                  Slot{0, {nullptr, nullptr}});
+            old.swap(slots_);
+            for (const Slot &slot : old) {
+                if (slot.range.min) {
+                    std::size_t i = home(slot.prefix);
+                    while (slots_[i].range.min) {
+                        i = (i + 1) & mask();
+                    }
+                    slots_[i] = slot;
+                }
+            }
+        }
+
+        std::vector<Slot> slots_;
+        std::size_t size_ = 0;
+    };
+
+  public:
+    /**
+     * @brief Forward iterator over the keys in ascending order.
+     */
+    class Iterator {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::uint64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::uint64_t *;
+        using reference = const std::uint64_t &;
+
+        Iterator() = default;
+        explicit Iterator(Node *node) : node_(node) {}
+
+        reference operator*() const { return node_->key; }
+        pointer operator->() const { return &node_->key; }
+
+        Iterator &operator++() {
+            node_ = node_->next()[0].node;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return node_ == other.node_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return node_ != other.node_;
+        }
+
+      private:
+        Node *node_ = nullptr;
+    };
+
+    SkipTrie()
+        : head_(createNode(0, kLevels)),
+          rngState_(skip_list_detail::nextSeed()) {}
+
+    ~SkipTrie() {
+        Node *cur = head_;
+        while (cur) {
+            Node *next = cur->next()[0].node;
+            destroyNode(cur);
+            cur = next;
+        }
+    }
+
+    SkipTrie(const SkipTrie &) = delete;
+    SkipTrie &operator=(const SkipTrie &) = delete;
+
+    /**
+     * @brief Inserts a key.
+     *
+     * @return false if the key was already present.
+     */
+    bool insert(std::uint64_t key) {
+        std::array<Node *, kLevels> update;
+        Node *pred = lastBefore(key, false, &update);
+        Node *found = pred->next()[0].node;
+        if (found && found->key == key) {
+            return false;
+        }
+
+        int height = std::min(
+            1 + std::countr_zero(skip_list_detail::splitmix64(rngState_)),
+            kLevels);
+        Node *node = createNode(key, height);
+        for (int l = 0; l < height; ++l) {
+            node->next()[l] = update[l]->next()[l];
+            update[l]->next()[l] = {node, key};
+        }
+        if (height == kLevels) {
+            node->prevTop = update[kTop] == head_ ? nullptr : update[kTop];
+            if (Node *after = node->next()[kTop].node) {
+                after->prevTop = node;
+            }
+            indexTop(node);
+        }
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @brief Removes a key.
+     *
+     * @return false if the key was not present.
+     */
+    bool erase(std::uint64_t key) {
+        std::array<Node *, kLevels> update;
+        Node *pred = lastBefore(key, false, &update);
+        Node *node = pred->next()[0].node;
+        if (!node || node->key != key) {
+            return false;
+        }
+
+        if (node->height == kLevels) {
+            unindexTop(node);
+            if (Node *after = node->next()[kTop].node) {
+                after->prevTop = node->prevTop;
+            }
+        }
+        for (int l = 0; l < node->height; ++l) {
+            update[l]->next()[l] = node->next()[l];
+        }
+        destroyNode(node);
+        --size_;
+        return true;
+    }
+
+    bool contains(std::uint64_t key) const {
+        Node *node = lastBefore(key, true);
+        return node != head_ && node->key == key;
+    }
+
+    /**
+     * @brief First key not less than @p key, i.e. its successor or itself.
+     */
+    Iterator lower_bound(std::uint64_t key) const {
+        return Iterator(lastBefore(key, false)->next()[0].node);
+    }
+
+    /**
+     * @brief First key greater than @p key.
+     */
+    Iterator upper_bound(std::uint64_t key) const {
+        return Iterator(lastBefore(key, true)->next()[0].node);
+    }
+
+    /**
+     * @brief Last key not greater than @p key, or end() if there is none.
+     */
+    Iterator predecessor(std::uint64_t key) const {
+        Node *node = lastBefore(key, true);
+        return node == head_ ? end() : Iterator(node);
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Number of keys indexed by the trie.
+     */
+    std::size_t topKeys() const { return prefixes_[kBits].size(); }
+
+    Iterator begin() const { return Iterator(head_->next()[0].node); }
+    Iterator end() const { return Iterator(); }
+
+  private:
+    static std::uint64_t prefix(std::uint64_t key, int length) {
+        return length == 0 ? 0 : key >> (kBits - length);
+    }
+
+    /**
+     * @brief Last top key not greater than @p key, or nullptr.
+     */
+    Node *topPredecessor(std::uint64_t key) const {
+        if (prefixes_[0].empty()) {
+            return nullptr;
+        }
+        // Longest prefix of the key shared with a top key
+        int lo = 0;
+        int hi = kBits;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (prefixes_[mid].find(prefix(key, mid))) {
+                lo = mid;
+            } else {
+                hi = mid - 1;
+            }
+        }
+        const Range &range = *prefixes_[lo].find(prefix(key, lo));
+        if (lo == kBits) {
+            return range.min; // The key itself
+        }
+        // Every top key below the prefix took the other branch
+        if ((key >> (kBits - 1 - lo)) & 1) {
+            return range.max;
+        }
+        return range.min->prevTop;
+    }
+
+    /**
+     * @brief Last node whose key is less than @p key (not greater if
+     * @p inclusive), or the head.
+     *
+     * The search starts at the closest top key found by the trie. If
+     * @p update is given it receives the last such node of every level.
+     */
+    Node *lastBefore(std::uint64_t key, bool inclusive,
+                     std::array<Node *, kLevels> *update = nullptr) const {
+        Node *top = nullptr;
+        if (inclusive) {
+            top = topPredecessor(key);
+        } else if (key > 0) {
+            top = topPredecessor(key - 1);
+        }
+        auto before = [&](const Link &link) {
+            return link.key < key || (inclusive && link.key == key);
+        };
+        Node *cur = top ? top : head_;
+        for (int l = kTop; l >= 0; --l) {
+            for (Link next = cur->next()[l]; next.node && before(next);
+                 next = cur->next()[l]) {
+                cur = next.node;
+            }
+            if (update) {
+                (*update)[l] = cur;
+            }
+        }
+        return cur;
+    }
+
+    void indexTop(Node *node) {
+        for (int length = 0; length <= kBits; ++length) {
+            auto [range, added] = prefixes_[length].tryEmplace(
+                prefix(node->key, length), Range{node, node});
+            if (added) {
+                continue;
+            }
+            if (node->key < range->min->key) {
+                range->min = node;
+            } else if (node->key > range->max->key) {
+                range->max = node;
+            }
+        }
+    }
+
+    /**
+     * @brief Removes a top key from the trie; must run while it is still
+     * linked to its neighbours.
+     */
+    void unindexTop(Node *node) {
+        for (int length = 0; length <= kBits; ++length) {
+            Range *range = prefixes_[length].find(prefix(node->key, length));
+            if (range->min == node && range->max == node) {
+                prefixes_[length].erase(range);
+            } else if (range->min == node) {
+                range->min = node->next()[kTop].node;
+            } else if (range->max == node) {
+                range->max = node->prevTop;
+            }
+        }
+    }
+
+    static Node *createNode(std::uint64_t key, int height) {
+        void *memory = ::operator new(sizeof(Node) + height * sizeof(Link));
+        Node *node = new (memory) Node{key, nullptr, height};
+        std::fill_n(node->next(), height, Link{nullptr, 0});
+        return node;
+    }
+
+    static void destroyNode(Node *node) {
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    Node *head_;
+    /// Prefix tables of the x-fast trie, indexed by prefix length
+    std::array<PrefixTable, kBits + 1> prefixes_;
+    std::size_t size_ = 0;
+    std::uint64_t rngState_;
+};
+
+#endif // SKIP_TRIE_HPP
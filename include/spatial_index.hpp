@@ -0,0 +1,202 @@
+#ifndef SPATIAL_INDEX_HPP
+#define SPATIAL_INDEX_HPP
+
+#include "skip_list.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Point of the 2D integer grid indexed by SpatialIndex.
+ */
+struct GridPoint {
+    std::uint32_t x;
+    std::uint32_t y;
+
+    bool operator==(const GridPoint &other) const = default;
+};
+
+/**
+ * @brief Axis-aligned rectangle with inclusive bounds.
+ */
+struct GridBox {
+    std::uint32_t xMin;
+    std::uint32_t yMin;
+    std::uint32_t xMax;
+    std::uint32_t yMax;
+
+    bool contains(const GridPoint &p) const {
+        return p.x >= xMin && p.x <= xMax && p.y >= yMin && p.y <= yMax;
+    }
+};
+
+/**
+ * @brief Set of 2D points stored as Z-order (Morton) keys in a SkipList.
+ *
+ * The bits of x and y are interleaved into one 64-bit key, so points close
+ * in the plane tend to be close in key order. A box query scans the key
+ * interval [z(min corner), z(max corner)]; whenever the scan reaches a key
+ * outside the box, the next key that can be inside it (BIGMIN, Tropf and
+ * Herzog) is computed and the scan jumps there with lower_bound(), so runs
+ * of points outside the box are skipped instead of visited.
+ */
+class SpatialIndex {
+  public:
+    /**
+     * @brief Constructs an empty index.
+     *
+     * @param probability      Probability p of the underlying skip list
+     * @param maxAllowedLevel  Level cap of the underlying skip list
+     */
+    explicit SpatialIndex(double probability = 0.5, int maxAllowedLevel = 32)
+        : keys_(probability, maxAllowedLevel) {}
+
+    /**
+     * @brief Adds a point.
+     *
+     * @return true if the point was not present before.
+     */
+    bool insert(const GridPoint &p) { return keys_.insert(encode(p)).second; }
+
+    /**
+     * @brief Removes a point.
+     *
+     * @return true if the point was present.
+     */
+    bool erase(const GridPoint &p) { return keys_.erase(encode(p)); }
+
+    bool contains(const GridPoint &p) const {
+        return keys_.contains(encode(p));
+    }
+
+    std::size_t size() const { return keys_.size(); }
+
+    /**
+     * @brief Calls @p visit for every point inside @p box, in Z-order.
+     *
+     * @return Number of points visited.
+     */
+    template <typename Visitor>
+    std::size_t query(const GridBox &box, Visitor visit) const {
+        const std::uint64_t zMin = encode({box.xMin, box.yMin});
+        const std::uint64_t zMax = encode({box.xMax, box.yMax});
+        std::size_t found = 0;
+
+        auto it = keys_.lower_bound(zMin);
+        while (it != keys_.end() && *it <= zMax) {
+            GridPoint p = decode(*it);
+            if (box.contains(p)) {
+                visit(p);
+                ++found;
+                ++it;
+            } else {
+                it = keys_.lower_bound(bigMin(*it, zMin, zMax));
+            }
+        }
+        return found;
+    }
+
+    /**
+     * @brief Returns every point inside @p box, in Z-order.
+     */
+    std::vector<GridPoint> query(const GridBox &box) const {
+        std::vector<GridPoint> points;
+        query(box, [&](const GridPoint &p) { points.push_back(p); });
+        return points;
+    }
+
+    /**
+     * @brief Interleaves the bits of a point: x takes the even bits, y the
+     * odd ones.
+     */
+    static std::uint64_t encode(const GridPoint &p) {
+        return spread(p.x) | (spread(p.y) << 1);
+    }
+
+    static GridPoint decode(std::uint64_t z) {
+        return {compact(z), compact(z >> 1)};
+    }
+
+    /**
+     * @brief Smallest Z-value greater than @p z that lies inside the box
+     * spanned by @p zMin and @p zMax.
+     *
+     * @p z must be inside [zMin, zMax] but outside the box.
+     */
+    static std::uint64_t bigMin(std::uint64_t z, std::uint64_t zMin,
+                                std::uint64_t zMax) {
+        std::uint64_t result = 0;
+        for (int bit = 63; bit >= 0; --bit) {
+            const std::uint64_t mask = std::uint64_t{1} << bit;
+            const bool v = z & mask;
+            const bool lo = zMin & mask;
+            const bool hi = zMax & mask;
+
+            if (!v && !lo && hi) {
+                result = load1000(zMin, bit);
+                zMax = load0111(zMax, bit);
+            } else if (!v && lo && hi) {
+                return zMin;
+            } else if (v && !lo && !hi) {
+                return result;
+            } else if (v && !lo && hi) {
+                zMin = load1000(zMin, bit);
+            }
+            // (0,0,0) and (1,1,1): same prefix, continue with the next bit
+        }
+        return result;
+    }
+
+  private:
+    static std::uint64_t spread(std::uint32_t v) {
+        std::uint64_t x = v;
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x << 2)) & 0x3333333333333333ull;
+        x = (x | (x << 1)) & 0x5555555555555555ull;
+        return x;
+    }
+
+    static std::uint32_t compact(std::uint64_t x) {
+        x &= 0x5555555555555555ull;
+        x = (x | (x >> 1)) & 0x3333333333333333ull;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFull;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFull;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFull;
+        return static_cast<std::uint32_t>(x);
+    }
+
+    /**
+     * @brief Bits of the same dimension as @p bit that are below it.
+     */
+    static std::uint64_t lowerBitsOfDim(int bit) {
+        const std::uint64_t dim =
+            bit % 2 == 0 ? 0x5555555555555555ull : 0xAAAAAAAAAAAAAAAAull;
+        return dim & ((std::uint64_t{1} << bit) - 1);
+    }
+
+    /**
+     * @brief Sets @p bit and clears the lower bits of its dimension
+     * ("1000…" pattern).
+     */
+    static std::uint64_t load1000(std::uint64_t v, int bit) {
+        const std::uint64_t mask = std::uint64_t{1} << bit;
+        return (v & ~(lowerBitsOfDim(bit) | mask)) | mask;
+    }
+
+    /**
+     * @brief Clears @p bit and sets the lower bits of its dimension
+     * ("0111…" pattern).
+     */
+    static std::uint64_t load0111(std::uint64_t v, int bit) {
+        const std::uint64_t lower = lowerBitsOfDim(bit);
+        return (v & ~(lower | (std::uint64_t{1} << bit))) | lower;
+    }
+
+    SkipList<std::uint64_t> keys_; ///< Z-order keys of the stored points
+};
+
+#endif // SPATIAL_INDEX_HPP
@@ -0,0 +1,105 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free single-producer/single-consumer ring buffer.
+ *
+ * One thread may push while another thread pops. Each side keeps a cached
+ * copy of the other side's index, so the shared cache line is only read when
+ * the ring looks full (producer) or empty (consumer).
+ *
+ * @tparam T element type, must be default constructible and copy assignable
+ */
+template <typename T> class SpscRing {
+  public:
+    /**
+     * @brief Constructs a ring able to hold at least @p capacity elements.
+     *
+     * The capacity is rounded up to a power of two.
+     */
+    explicit SpscRing(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /**
+     * @brief Appends an element (producer side).
+     *
+     * @return false if the ring is full.
+     */
+    bool tryPush(const T &value) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) {
+                return false;
+            }
+        }
+        buffer_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element (consumer side).
+     *
+     * @return false if the ring is empty.
+     */
+    bool tryPop(T &value) { return popBatch(&value, 1) == 1; }
+
+    /**
+     * @brief Removes up to @p max of the oldest elements (consumer side).
+     *
+     * @return Number of elements written to @p out.
+     */
+    std::size_t popBatch(T *out, std::size_t max) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (cachedTail_ - head < max) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+        }
+        std::size_t count = cachedTail_ - head;
+        if (count > max) {
+            count = max;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = buffer_[(head + i) & mask_];
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Approximate number of stored elements.
+     */
+    std::size_t size() const {
+        return tail_.load(std::memory_order_acquire) -
+               head_.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+  private:
+    static constexpr std::size_t kCacheLine = 64;
+
+    std::vector<T> buffer_;
+    std::size_t mask_;
+
+    alignas(kCacheLine) std::atomic<std::size_t> head_{0}; ///< Next to pop
+    std::size_t cachedTail_ = 0; ///< Consumer's copy of tail_
+
+    alignas(kCacheLine) std::atomic<std::size_t> tail_{0}; ///< Next to push
+    std::size_t cachedHead_ = 0; ///< Producer's copy of head_
+};
+
+#endif // SPSC_RING_HPP
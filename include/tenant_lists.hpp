@@ -0,0 +1,387 @@
+#ifndef TENANT_LISTS_HPP
+#define TENANT_LISTS_HPP
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Pool of fixed-size chunks shared by the heaps of many tenants.
+ *
+ * Chunks given back by a tenant are kept and handed to the next tenant that
+ * needs one, so dropping and creating tenants does not go back to the
+ * global heap and memory is only ever cut into chunks of one size.
+ */
+class NodeArena {
+  public:
+    /**
+     * @param chunkSize Size of every chunk in bytes, a multiple of the
+     * allocation granule
+     */
+    explicit NodeArena(std::size_t chunkSize = 4096) : chunkSize_(chunkSize) {
+        assert(chunkSize_ % alignof(std::max_align_t) == 0);
+    }
+
+    ~NodeArena() {
+        assert(free_.size() == allocated_ && "chunks still owned by a heap");
+        for (void *chunk : free_) {
+            ::operator delete(chunk);
+        }
+    }
+
+    NodeArena(const NodeArena &) = delete;
+    NodeArena &operator=(const NodeArena &) = delete;
+
+    /**
+     * @brief Takes a chunk, reusing a released one if possible.
+     */
+    void *acquireChunk() {
+        if (free_.empty()) {
+            void *chunk = ::operator new(chunkSize_);
+            ++allocated_;
+            return chunk;
+        }
+        void *chunk = free_.back();
+        free_.pop_back();
+        return chunk;
+    }
+
+    void releaseChunk(void *chunk) { free_.push_back(chunk); }
+
+    std::size_t chunkSize() const { return chunkSize_; }
+
+    /**
+     * @brief Number of chunks taken from the global heap so far.
+     */
+    std::size_t chunksAllocated() const { return allocated_; }
+
+    /**
+     * @brief Number of chunks waiting for reuse.
+     */
+    std::size_t chunksFree() const { return free_.size(); }
+
+  private:
+    std::size_t chunkSize_;
+    std::size_t allocated_ = 0;
+    std::vector<void *> free_;
+};
+
+/**
+ * @brief Thrown when an allocation would take a tenant over its quota.
+ */
+class QuotaExceeded : public std::bad_alloc {
+  public:
+    const char *what() const noexcept override {
+        return "tenant memory quota exceeded";
+    }
+};
+
+/**
+ * @brief Memory of one tenant, carved from chunks of a NodeArena.
+ *
+ * Blocks are rounded up to the allocation granule and bump-allocated from
+ * the current chunk; a freed block goes to the free list of its size and
+ * is reused by the next block of that size. Chunks are only returned to
+ * the arena all at once, by release() or the destructor.
+ *
+ * usedBytes() counts the live blocks and is what the quota limits;
+ * reservedBytes() counts the chunks held.
+ */
+class TenantHeap {
+  public:
+    static constexpr std::size_t kGranule = alignof(std::max_align_t);
+
+    TenantHeap(NodeArena &arena, std::size_t quota)
+        : arena_(&arena), quota_(quota),
+          freeLists_(arena.chunkSize() / kGranule + 1, nullptr) {}
+
+    ~TenantHeap() { release(); }
+
+    TenantHeap(const TenantHeap &) = delete;
+    TenantHeap &operator=(const TenantHeap &) = delete;
+
+    /**
+     * @brief Allocates @p bytes aligned to the granule.
+     *
+     * @throws QuotaExceeded if the tenant would go over its quota.
+     * @throws std::bad_alloc if the block does not fit in a chunk.
+     */
+    void *allocate(std::size_t bytes) {
+        bytes = roundUp(bytes);
+        if (bytes > arena_->chunkSize()) {
+            throw std::bad_alloc();
+        }
+        if (used_ + bytes > quota_) {
+            throw QuotaExceeded();
+        }
+
+        void *&freeList = freeLists_[bytes / kGranule];
+        void *block;
+        if (freeList) {
+            block = freeList;
+            freeList = *static_cast<void **>(block);
+        } else {
+            if (bytes > left_) {
+                cursor_ = static_cast<unsigned char *>(arena_->acquireChunk());
+                chunks_.push_back(cursor_);
+                left_ = arena_->chunkSize();
+            }
+            block = cursor_;
+            cursor_ += bytes;
+            left_ -= bytes;
+        }
+        used_ += bytes;
+        return block;
+    }
+
+    void deallocate(void *block, std::size_t bytes) {
+        bytes = roundUp(bytes);
+        void *&freeList = freeLists_[bytes / kGranule];
+        *static_cast<void **>(block) = freeList;
+        freeList = block;
+        used_ -= bytes;
+    }
+
+    /**
+     * @brief Gives every chunk back to the arena at once.
+     *
+     * Every block becomes invalid, whether it was freed or not.
+     */
+    void release() {
+        for (void *chunk : chunks_) {
+            arena_->releaseChunk(chunk);
+        }
+        chunks_.clear();
+        std::fill(freeLists_.begin(), freeLists_.end(), nullptr);
+        cursor_ = nullptr;
+        left_ = 0;
+        used_ = 0;
+    }
+
+    std::size_t usedBytes() const { return used_; }
+    std::size_t reservedBytes() const {
+        return chunks_.size() * arena_->chunkSize();
+    }
+
+    std::size_t quota() const { return quota_; }
+
+    /**
+     * @brief Changes the quota; blocks already allocated are kept even if
+     * they exceed it.
+     */
+    void setQuota(std::size_t quota) { quota_ = quota; }
+
+  private:
+    static std::size_t roundUp(std::size_t bytes) {
+        return (bytes + kGranule - 1) / kGranule * kGranule;
+    }
+
+    NodeArena *arena_;
+    std::size_t quota_;
+    std::size_t used_ = 0;
+    std::vector<void *> chunks_;
+    std::vector<void *> freeLists_; ///< Indexed by size in granules
+    unsigned char *cursor_ = nullptr; ///< Bump pointer in the last chunk
+    std::size_t left_ = 0;            ///< Bytes left after cursor_
+};
+
+/**
+ * @brief Allocator drawing from a TenantHeap.
+ */
+template <typename T> class TenantAllocator {
+  public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= TenantHeap::kGranule,
+                  "over-aligned types are not supported");
+
+    explicit TenantAllocator(TenantHeap &heap) : heap_(&heap) {}
+
+    template <typename U>
+    TenantAllocator(const TenantAllocator<U> &other) : heap_(other.heap()) {}
+
+    T *allocate(std::size_t n) {
+        return static_cast<T *>(heap_->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        heap_->deallocate(p, n * sizeof(T));
+    }
+
+    TenantHeap *heap() const { return heap_; }
+
+    template <typename U>
+    bool operator==(const TenantAllocator<U> &other) const {
+        return heap_ == other.heap();
+    }
+
+  private:
+    TenantHeap *heap_;
+};
+
+/**
+ * @brief One skip list per tenant, all sharing a NodeArena.
+ *
+ * Each tenant has its own TenantHeap, so its memory is accounted and
+ * limited separately, and dropping a tenant gives its chunks back to the
+ * arena in one pass over the chunks instead of one free per node. With
+ * trivially destructible keys the nodes are not even visited.
+ *
+ * An insert that would take a tenant over its quota throws QuotaExceeded
+ * and leaves the list unchanged.
+ *
+ * @tparam Key      key type of the lists
+ * @tparam TenantId hashable identifier of a tenant
+ */
+template <typename Key, typename TenantId = std::uint64_t> class TenantLists {
+  public:
+    using List = SkipList<Key, TenantAllocator<Key>>;
+
+    /**
+     * @param defaultQuota    Quota in bytes of tenants opened without one
+     * @param chunkSize       Size of the arena chunks in bytes
+     * @param probability     Probability p of the lists
+     * @param maxAllowedLevel Maximum level of the lists; the head of every
+     * list holds this many links
+     * @param mode            Height mode of the lists; with
+     * LevelMode::Hashed the memory a tenant uses depends only on its keys
+     */
+    explicit TenantLists(std::size_t defaultQuota,
+                         std::size_t chunkSize = 4096,
+                         double probability = 0.5, int maxAllowedLevel = 16,
+                         LevelMode mode = LevelMode::Random)
+        : arena_(chunkSize), defaultQuota_(defaultQuota),
+          probability_(probability), maxAllowedLevel_(maxAllowedLevel),
+          mode_(mode) {}
+
+    ~TenantLists() {
+        for (auto &entry : tenants_) {
+            abandonIfTrivial(entry.second->list);
+        }
+        tenants_.clear();
+    }
+
+    TenantLists(const TenantLists &) = delete;
+    TenantLists &operator=(const TenantLists &) = delete;
+
+    /**
+     * @brief Returns the list of @p id, creating it with the default quota
+     * if needed.
+     */
+    List &open(const TenantId &id) { return open(id, defaultQuota_); }
+
+    /**
+     * @brief Returns the list of @p id, creating it with @p quota if needed.
+     *
+     * The quota of an existing tenant is left unchanged.
+     */
+    List &open(const TenantId &id, std::size_t quota) {
+        auto it = tenants_.find(id);
+        if (it == tenants_.end()) {
+            it = tenants_
+                     .emplace(id, std::make_unique<Tenant>(
+                                      arena_, quota, probability_,
+                                      maxAllowedLevel_, mode_))
+                     .first;
+        }
+        return it->second->list;
+    }
+
+    /**
+     * @brief Returns the list of @p id, or nullptr if it is not open.
+     */
+    List *find(const TenantId &id) {
+        auto it = tenants_.find(id);
+        return it == tenants_.end() ? nullptr : &it->second->list;
+    }
+
+    /**
+     * @brief Destroys the list of @p id and returns its chunks to the
+     * arena.
+     *
+     * @return false if the tenant is not open.
+     */
+    bool drop(const TenantId &id) {
+        auto it = tenants_.find(id);
+        if (it == tenants_.end()) {
+            return false;
+        }
+        abandonIfTrivial(it->second->list);
+        tenants_.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Changes the quota of an open tenant.
+     *
+     * @return false if the tenant is not open.
+     */
+    bool setQuota(const TenantId &id, std::size_t quota) {
+        auto it = tenants_.find(id);
+        if (it == tenants_.end()) {
+            return false;
+        }
+        it->second->heap.setQuota(quota);
+        return true;
+    }
+
+    /**
+     * @brief Bytes held by the nodes of a tenant, 0 if it is not open.
+     */
+    std::size_t usedBytes(const TenantId &id) const {
+        auto it = tenants_.find(id);
+        return it == tenants_.end() ? 0 : it->second->heap.usedBytes();
+    }
+
+    /**
+     * @brief Bytes of the chunks held by a tenant, 0 if it is not open.
+     */
+    std::size_t reservedBytes(const TenantId &id) const {
+        auto it = tenants_.find(id);
+        return it == tenants_.end() ? 0 : it->second->heap.reservedBytes();
+    }
+
+    std::size_t tenantCount() const { return tenants_.size(); }
+
+    const NodeArena &arena() const { return arena_; }
+
+  private:
+    struct Tenant {
+        TenantHeap heap; ///< Declared first: outlives the list
+        List list;
+
+        Tenant(NodeArena &arena, std::size_t quota, double probability,
+               int maxAllowedLevel, LevelMode mode)
+            : heap(arena, quota),
+              list(probability, maxAllowedLevel, mode,
+                   TenantAllocator<Key>(heap)) {}
+    };
+
+    /**
+     * @brief Lets the heap release the nodes of @p list with its chunks
+     * when no key destructor has to run.
+     */
+    static void abandonIfTrivial(List &list) {
+        if constexpr (std::is_trivially_destructible_v<Key>) {
+            list.abandon();
+        }
+    }
+
+    NodeArena arena_; ///< Declared first: outlives every tenant
+    std::size_t defaultQuota_;
+    double probability_;
+    int maxAllowedLevel_;
+    LevelMode mode_;
+    std::unordered_map<TenantId, std::unique_ptr<Tenant>> tenants_;
+};
+
+#endif // TENANT_LISTS_HPP
@@ -0,0 +1,224 @@
+#ifndef TIMER_SERVICE_HPP
+#define TIMER_SERVICE_HPP
+
+#include "skip_list_map.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+/**
+ * @brief Identifies a timer scheduled on a TimerService.
+ *
+ * A handle stays safe to use after its timer fired or was cancelled: the
+ * generation no longer matches and cancel() returns false.
+ */
+struct TimerHandle {
+    std::uint32_t slot = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t generation = 0;
+};
+
+/**
+ * @brief Deadline scheduler keeping its timers in a SkipListMap.
+ *
+ * Deadlines are rounded up to a multiple of the resolution and every
+ * distinct rounded deadline is one bucket node of the map. The timers of a
+ * bucket form a doubly linked list through their slots, so cancelling a
+ * timer unlinks its slot in O(1) and, when the bucket becomes empty, drops
+ * the bucket node through the O(1) lazy SkipList::erase(Iterator).
+ * popExpired() cuts every bucket up to @c now off the front of the map at
+ * once with eraseBelow().
+ *
+ * With a coarse resolution, near deadlines share a few buckets, so
+ * scheduling mostly appends to an existing node; timers then fire up to one
+ * resolution late, never early.
+ */
+class TimerService {
+  public:
+    /**
+     * @brief Constructs an empty scheduler.
+     *
+     * @param resolution Granularity deadlines are rounded up to (1 keeps
+     * them exact)
+     */
+    explicit TimerService(std::uint64_t resolution = 1)
+        : resolution_(resolution ? resolution : 1) {
+        buckets_.setLazyErase(true);
+    }
+
+    /**
+     * @brief Schedules @p payload to expire at @p deadline.
+     *
+     * A deadline of UINT64_MAX never expires.
+     */
+    TimerHandle schedule(std::uint64_t deadline, std::uint64_t payload) {
+        auto bucket = buckets_.emplace(roundUp(deadline), Bucket{}).first;
+        std::uint32_t index = allocate();
+        Slot &slot = slots_[index];
+        slot.payload = payload;
+        slot.bucket = bucket;
+        slot.prev = bucket->value.tail;
+        slot.next = kNone;
+        slot.armed = true;
+
+        Bucket &b = bucket->value;
+        if (b.tail == kNone) {
+            b.head = index;
+        } else {
+            slots_[b.tail].next = index;
+        }
+        b.tail = index;
+        ++armed_;
+        return {index, slot.generation};
+    }
+
+    /**
+     * @brief Cancels a pending timer in O(1).
+     *
+     * @return false if the timer already fired or was cancelled.
+     */
+    bool cancel(TimerHandle handle) {
+        if (handle.slot >= slots_.size()) {
+            return false;
+        }
+        Slot &slot = slots_[handle.slot];
+        if (!slot.armed || slot.generation != handle.generation) {
+            return false;
+        }
+
+        Bucket &b = slot.bucket->value;
+        if (slot.prev == kNone) {
+            b.head = slot.next;
+        } else {
+            slots_[slot.prev].next = slot.next;
+        }
+        if (slot.next == kNone) {
+            b.tail = slot.prev;
+        } else {
+            slots_[slot.next].prev = slot.prev;
+        }
+        if (b.head == kNone) {
+            buckets_.erase(slot.bucket);
+        }
+        release(handle.slot);
+        --armed_;
+        return true;
+    }
+
+    /**
+     * @brief Fires every timer whose rounded deadline is not after @p now.
+     *
+     * Timers fire in deadline order, and in scheduling order within a
+     * bucket. All of them are removed before the first call of @p visit, so
+     * the visitor may schedule and cancel timers but must not call
+     * popExpired().
+     *
+     * @param visit Called as visit(std::uint64_t payload)
+     * @return Number of timers fired.
+     */
+    template <typename Visitor>
+    std::size_t popExpired(std::uint64_t now, Visitor visit) {
+        if (now == std::numeric_limits<std::uint64_t>::max()) {
+            --now;
+        }
+        fired_.clear();
+        buckets_.eraseBelow(now + 1, [this](const Buckets::Entry &entry) {
+            std::uint32_t index = entry.value.head;
+            while (index != kNone) {
+                std::uint32_t next = slots_[index].next;
+                fired_.push_back(slots_[index].payload);
+                release(index);
+                index = next;
+            }
+        });
+        armed_ -= fired_.size();
+        for (std::uint64_t payload : fired_) {
+            visit(payload);
+        }
+        return fired_.size();
+    }
+
+    /**
+     * @brief Earliest rounded deadline of a pending timer.
+     */
+    std::optional<std::uint64_t> nextDeadline() const {
+        if (buckets_.empty()) {
+            return std::nullopt;
+        }
+        return buckets_.begin()->key;
+    }
+
+    /**
+     * @brief Number of pending timers.
+     */
+    std::size_t size() const { return armed_; }
+    bool empty() const { return armed_ == 0; }
+
+    /**
+     * @brief Number of distinct rounded deadlines, i.e. skip list nodes.
+     */
+    std::size_t bucketCount() const { return buckets_.size(); }
+
+  private:
+    static constexpr std::uint32_t kNone =
+        std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @brief Timers sharing one rounded deadline, as a list of slots.
+     */
+    struct Bucket {
+        std::uint32_t head = kNone;
+        std::uint32_t tail = kNone;
+    };
+
+    using Buckets = SkipListMap<std::uint64_t, Bucket>;
+
+    struct Slot {
+        std::uint64_t payload = 0;
+        Buckets::Iterator bucket;
+        std::uint32_t prev = kNone;
+        std::uint32_t next = kNone; ///< Also links the free slots
+        std::uint32_t generation = 0;
+        bool armed = false;
+    };
+
+    std::uint64_t roundUp(std::uint64_t deadline) const {
+        std::uint64_t rest = deadline % resolution_;
+        if (rest == 0) {
+            return deadline;
+        }
+        std::uint64_t gap = resolution_ - rest;
+        return deadline > std::numeric_limits<std::uint64_t>::max() - gap
+                   ? std::numeric_limits<std::uint64_t>::max()
+                   : deadline + gap;
+    }
+
+    std::uint32_t allocate() {
+        if (freeHead_ == kNone) {
+            slots_.emplace_back();
+            return static_cast<std::uint32_t>(slots_.size() - 1);
+        }
+        std::uint32_t index = freeHead_;
+        freeHead_ = slots_[index].next;
+        return index;
+    }
+
+    void release(std::uint32_t index) {
+        Slot &slot = slots_[index];
+        slot.armed = false;
+        ++slot.generation;
+        slot.next = freeHead_;
+        freeHead_ = index;
+    }
+
+    std::uint64_t resolution_;
+    Buckets buckets_;
+    std::vector<Slot> slots_;
+    std::uint32_t freeHead_ = kNone;
+    std::size_t armed_ = 0;
+    std::vector<std::uint64_t> fired_; ///< Scratch buffer of popExpired()
+};
+
+#endif // TIMER_SERVICE_HPP
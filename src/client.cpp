@@ -0,0 +1,211 @@
+#include "kv_protocol.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Load generator configuration.
+ */
+struct Config {
+    std::string path = "/tmp/skip_list.sock";
+    unsigned connections = 1;
+    std::uint64_t requests = 1000000; ///< Requests per connection
+    unsigned pipeline = 64;           ///< Requests in flight per connection
+    std::uint64_t keySpace = 1000000;
+    double getRatio = 0.8;
+    double delRatio = 0.05;
+};
+
+int connectTo(const std::string &path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        close(fd);
+        return -1;
+    }
+    std::strcpy(addr.sun_path, path.c_str());
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const unsigned char *data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool recvAll(int fd, unsigned char *data, std::size_t size) {
+    while (size > 0) {
+        ssize_t n = recv(fd, data, size, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief Per-connection counters.
+ */
+struct Stats {
+    std::uint64_t completed = 0;
+    std::uint64_t hits = 0;
+    bool failed = false;
+};
+
+/**
+ * @brief Sends pipelined batches of random requests over one connection.
+ *
+ * Each batch of @c pipeline requests is written with one send, then all of
+ * its responses are read back before the next batch is issued.
+ */
+void runConnection(const Config &cfg, unsigned id, Stats &stats) {
+    int fd = connectTo(cfg.path);
+    if (fd < 0) {
+        stats.failed = true;
+        return;
+    }
+
+    std::mt19937_64 rng(id + 1);
+    std::uniform_int_distribution<std::uint64_t> keyDist(0, cfg.keySpace - 1);
+    std::uniform_real_distribution<double> opDist(0.0, 1.0);
+
+    std::vector<unsigned char> out(cfg.pipeline * kv::kRequestSize);
+    std::vector<unsigned char> in(cfg.pipeline * kv::kResponseSize);
+
+    while (stats.completed < cfg.requests) {
+        auto batch = static_cast<unsigned>(std::min<std::uint64_t>(
+            cfg.pipeline, cfg.requests - stats.completed));
+        for (unsigned i = 0; i < batch; ++i) {
+            double r = opDist(rng);
+            kv::Request req{kv::Op::Put, keyDist(rng), 0};
+            if (r < cfg.getRatio) {
+                req.op = kv::Op::Get;
+            } else if (r < cfg.getRatio + cfg.delRatio) {
+                req.op = kv::Op::Del;
+            } else {
+                req.value = rng();
+            }
+            kv::encode(req, out.data() + i * kv::kRequestSize);
+        }
+        if (!sendAll(fd, out.data(), batch * kv::kRequestSize) ||
+            !recvAll(fd, in.data(), batch * kv::kResponseSize)) {
+            stats.failed = true;
+            break;
+        }
+        for (unsigned i = 0; i < batch; ++i) {
+            auto resp = kv::decodeResponse(in.data() + i * kv::kResponseSize);
+            stats.hits += resp.status == kv::Status::Ok;
+        }
+        stats.completed += batch;
+    }
+    close(fd);
+}
+
+bool parseArgs(int argc, char **argv, Config &cfg) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *v = argv[++i];
+        if (arg == "--socket") {
+            cfg.path = v;
+        } else if (arg == "--connections") {
+            cfg.connections = static_cast<unsigned>(std::stoul(v));
+        } else if (arg == "--requests") {
+            cfg.requests = std::stoull(v);
+        } else if (arg == "--pipeline") {
+            cfg.pipeline = static_cast<unsigned>(std::stoul(v));
+        } else if (arg == "--keys") {
+            cfg.keySpace = std::stoull(v);
+        } else if (arg == "--get-ratio") {
+            cfg.getRatio = std::stod(v);
+        } else if (arg == "--del-ratio") {
+            cfg.delRatio = std::stod(v);
+        } else {
+            return false;
+        }
+    }
+    return cfg.connections > 0 && cfg.pipeline > 0 && cfg.keySpace > 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Config cfg;
+    if (!parseArgs(argc, argv, cfg)) {
+        std::cerr << "Usage: skip_list_client [--socket PATH] "
+                     "[--connections N] [--requests N]\n"
+                     "                        [--pipeline DEPTH] [--keys N] "
+                     "[--get-ratio R] [--del-ratio R]\n";
+        return 1;
+    }
+
+    std::vector<Stats> stats(cfg.connections);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < cfg.connections; ++i) {
+        workers.emplace_back(runConnection, std::cref(cfg), i,
+                             std::ref(stats[i]));
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::uint64_t completed = 0;
+    std::uint64_t hits = 0;
+    for (const auto &s : stats) {
+        if (s.failed) {
+            std::cerr << "A connection to " << cfg.path << " failed\n";
+            return 1;
+        }
+        completed += s.completed;
+        hits += s.hits;
+    }
+
+    std::cout << "connections:  " << cfg.connections << ", pipeline "
+              << cfg.pipeline << '\n';
+    std::cout << "requests:     " << completed << " in " << elapsed.count()
+              << " s, " << completed / elapsed.count() << " ops/s\n";
+    std::cout << "ok responses: " << hits << '\n';
+    return 0;
+}
@@ -1,3 +1,483 @@
-#include "iostream"
+#include "skip_list.hpp"
 
-int main() { std::cout << "Hello, world!"; }
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Kind of a single trace operation.
+ */
+enum class OpType : std::uint8_t {
+    Insert = 0,
+    Erase = 1,
+    Contains = 2,
+    Scan = 3
+};
+
+/**
+ * @brief One operation of a replayed trace.
+ *
+ * In binary traces every operation is a 16‑byte little‑endian record:
+ * op (1 byte), 3 padding bytes, count (4 bytes), key (8 bytes).
+ */
+struct Op {
+    OpType type;
+    std::uint32_t count; ///< Number of keys visited by a scan
+    std::uint64_t key;
+};
+
+/**
+ * @brief How the replayed list is shared between threads.
+ */
+enum class Mode { Single, Mutex };
+
+/**
+ * @brief Command line configuration of a replay run.
+ */
+struct Config {
+    std::string keysPath;
+    std::string tracePath;
+    bool binary = false;
+    bool lazyErase = false;
+    bool hashedLevels = false;
+    double probability = 0.5;
+    int maxLevel = 32;
+    Mode mode = Mode::Single;
+    unsigned threads = 1;
+};
+
+void printUsage(std::ostream &os) {
+    os << "Usage: skip_list --trace FILE [options]\n"
+          "\n"
+          "Replays an operation trace against a SkipList<uint64_t>.\n"
+          "\n"
+          "Options:\n"
+          "  --keys FILE        keys inserted before the replay starts\n"
+          "  --trace FILE       operations to replay\n"
+          "  --binary           read both files in binary format\n"
+          "  --p P              promotion probability (default 0.5)\n"
+          "  --max-level L      level cap (default 32)\n"
+          "  --lazy-erase       mark erased keys and purge them in batches\n"
+          "  --hashed-levels    derive node heights from the key hash\n"
+          "  --mode single|mutex\n"
+          "                     single thread, or threads sharing one list\n"
+          "                     behind a mutex (default single)\n"
+          "  --threads N        replay threads for --mode mutex (default 1)\n"
+          "\n"
+          "Text traces hold one operation per line:\n"
+          "  insert KEY | erase KEY | contains KEY | scan KEY COUNT\n"
+          "(the first letter is enough; '#' starts a comment).\n"
+          "Binary key files are raw uint64 arrays, binary traces are\n"
+          "16-byte records {u8 op, u8 pad[3], u32 count, u64 key}.\n";
+}
+
+/**
+ * @brief Parses the value @p v of option @p arg into @p out, rejecting
+ * malformed or out-of-range numbers and trailing characters. Unsigned
+ * values must start with a digit.
+ */
+template <typename T>
+bool parseNumber(const std::string &arg, const char *v, T &out) {
+    std::size_t pos = 0;
+    try {
+        if constexpr (std::is_floating_point_v<T>) {
+            out = std::stod(v, &pos);
+        } else if constexpr (std::is_signed_v<T>) {
+            out = std::stoi(v, &pos);
+        } else {
+            // stoul() skips spaces and wraps negative numbers around
+            unsigned long value = std::stoul(v, &pos);
+            if (value > std::numeric_limits<T>::max() ||
+                !std::isdigit(static_cast<unsigned char>(v[0]))) {
+                pos = 0;
+            }
+            out = static_cast<T>(value);
+        }
+    } catch (const std::exception &) {
+        pos = 0;
+    }
+    if (pos == 0 || v[pos] != '\0') {
+        std::cerr << "Invalid value for " << arg << ": " << v << '\n';
+        return false;
+    }
+    return true;
+}
+
+bool parseArgs(int argc, char **argv, Config &cfg) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char * {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "--binary") {
+            cfg.binary = true;
+            continue;
+        }
+        if (arg == "--lazy-erase") {
+            cfg.lazyErase = true;
+            continue;
+        }
+        if (arg == "--hashed-levels") {
+            cfg.hashedLevels = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+
+        const char *v = value();
+        if (!v) {
+            std::cerr << "Missing value for " << arg << '\n';
+            return false;
+        }
+        if (arg == "--keys") {
+            cfg.keysPath = v;
+        } else if (arg == "--trace") {
+            cfg.tracePath = v;
+        } else if (arg == "--p") {
+            if (!parseNumber(arg, v, cfg.probability)) {
+                return false;
+            }
+        } else if (arg == "--max-level") {
+            if (!parseNumber(arg, v, cfg.maxLevel)) {
+                return false;
+            }
+        } else if (arg == "--threads") {
+            if (!parseNumber(arg, v, cfg.threads)) {
+                return false;
+            }
+        } else if (arg == "--mode") {
+            std::string mode = v;
+            if (mode == "single") {
+                cfg.mode = Mode::Single;
+            } else if (mode == "mutex") {
+                cfg.mode = Mode::Mutex;
+            } else {
+                std::cerr << "Unknown mode: " << mode << '\n';
+                return false;
+            }
+        } else {
+            std::cerr << "Unknown option: " << arg << '\n';
+            return false;
+        }
+    }
+
+    if (cfg.tracePath.empty()) {
+        std::cerr << "--trace is required\n";
+        return false;
+    }
+    if (cfg.probability <= 0.0 || cfg.probability >= 1.0 ||
+        cfg.maxLevel < 1 || cfg.threads < 1) {
+        std::cerr << "Invalid list configuration\n";
+        return false;
+    }
+    if (cfg.mode == Mode::Single && cfg.threads != 1) {
+        std::cerr << "--threads requires --mode mutex\n";
+        return false;
+    }
+    return true;
+}
+
+bool loadKeys(const Config &cfg, std::vector<std::uint64_t> &keys) {
+    if (cfg.keysPath.empty()) {
+        return true;
+    }
+    std::ifstream in(cfg.keysPath, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << cfg.keysPath << '\n';
+        return false;
+    }
+
+    if (cfg.binary) {
+        std::uint64_t key;
+        while (in.read(reinterpret_cast<char *>(&key), sizeof(key))) {
+            keys.push_back(key);
+        }
+        if (in.gcount() != 0) {
+            std::cerr << "Truncated key at the end of " << cfg.keysPath
+                      << '\n';
+            return false;
+        }
+    } else {
+        std::uint64_t key;
+        while (in >> key) {
+            keys.push_back(key);
+        }
+        if (!in.eof()) {
+            std::cerr << "Malformed key in " << cfg.keysPath << '\n';
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseTextOp(const std::string &line, Op &op) {
+    std::istringstream is(line);
+    std::string name;
+    is >> name;
+
+    switch (name[0]) {
+    case 'i':
+        op.type = OpType::Insert;
+        break;
+    case 'e':
+        op.type = OpType::Erase;
+        break;
+    case 'c':
+        op.type = OpType::Contains;
+        break;
+    case 's':
+        op.type = OpType::Scan;
+        break;
+    default:
+        return false;
+    }
+
+    op.count = 0;
+    if (!(is >> op.key)) {
+        return false;
+    }
+    if (op.type == OpType::Scan && !(is >> op.count)) {
+        return false;
+    }
+    return true;
+}
+
+bool loadTrace(const Config &cfg, std::vector<Op> &ops) {
+    std::ifstream in(cfg.tracePath, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << cfg.tracePath << '\n';
+        return false;
+    }
+
+    if (cfg.binary) {
+        unsigned char record[16];
+        while (in.read(reinterpret_cast<char *>(record), sizeof(record))) {
+            Op op;
+            if (record[0] > static_cast<unsigned char>(OpType::Scan)) {
+                std::cerr << "Bad opcode in record " << ops.size() << '\n';
+                return false;
+            }
+            op.type = static_cast<OpType>(record[0]);
+            std::memcpy(&op.count, record + 4, sizeof(op.count));
+            std::memcpy(&op.key, record + 8, sizeof(op.key));
+            ops.push_back(op);
+        }
+        if (in.gcount() != 0) {
+            std::cerr << "Truncated record at the end of " << cfg.tracePath
+                      << '\n';
+            return false;
+        }
+        return true;
+    }
+
+    std::string line;
+    std::size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        Op op;
+        if (!parseTextOp(line.substr(first), op)) {
+            std::cerr << cfg.tracePath << ':' << lineNo
+                      << ": malformed operation\n";
+            return false;
+        }
+        ops.push_back(op);
+    }
+    return true;
+}
+
+/**
+ * @brief Applies one operation and returns a value that depends on its
+ * result, so the work cannot be optimised away.
+ */
+std::uint64_t apply(SkipList<std::uint64_t> &list, const Op &op) {
+    switch (op.type) {
+    case OpType::Insert:
+        list.insert(op.key);
+        return 0;
+    case OpType::Erase:
+        return list.erase(op.key);
+    case OpType::Contains:
+        return list.contains(op.key);
+    case OpType::Scan: {
+        std::uint64_t sum = 0;
+        auto it = list.lower_bound(op.key);
+        for (std::uint32_t i = 0; i < op.count && it != list.end(); ++i) {
+            sum += *it++;
+        }
+        return sum;
+    }
+    }
+    return 0;
+}
+
+/**
+ * @brief Replays every @p stride -th operation starting at @p first and
+ * records the latency of each one in nanoseconds.
+ */
+template <typename Lock>
+std::uint64_t replay(SkipList<std::uint64_t> &list, const std::vector<Op> &ops,
+                     std::size_t first, std::size_t stride, Lock lock,
+                     std::vector<std::uint64_t> &latencies) {
+    std::uint64_t checksum = 0;
+    for (std::size_t i = first; i < ops.size(); i += stride) {
+        auto start = Clock::now();
+        {
+            [[maybe_unused]] auto guard = lock();
+            checksum += apply(list, ops[i]);
+        }
+        auto stop = Clock::now();
+        latencies.push_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start)
+                .count());
+    }
+    return checksum;
+}
+
+/**
+ * @brief Peak resident set size of the process in kilobytes.
+ */
+long peakRssKb() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/**
+ * @brief Current resident set size of the process in kilobytes, or -1 if it
+ * cannot be determined.
+ */
+long currentRssKb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return -1;
+}
+
+void printLatencies(std::vector<std::uint64_t> &latencies) {
+    if (latencies.empty()) {
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double q) {
+        auto idx = static_cast<std::size_t>(q * (latencies.size() - 1));
+        return latencies[idx];
+    };
+    std::cout << "latency ns:   p50 " << percentile(0.50) << ", p90 "
+              << percentile(0.90) << ", p99 " << percentile(0.99)
+              << ", p99.9 " << percentile(0.999) << ", max "
+              << latencies.back() << '\n';
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Config cfg;
+    if (!parseArgs(argc, argv, cfg)) {
+        printUsage(std::cerr);
+        return 1;
+    }
+
+    std::vector<std::uint64_t> keys;
+    std::vector<Op> ops;
+    if (!loadKeys(cfg, keys) || !loadTrace(cfg, ops)) {
+        return 1;
+    }
+
+    long rssBefore = currentRssKb();
+    SkipList<std::uint64_t> list(cfg.probability, cfg.maxLevel,
+                                 cfg.hashedLevels ? LevelMode::Hashed
+                                                  : LevelMode::Random);
+    list.setLazyErase(cfg.lazyErase);
+
+    auto loadStart = Clock::now();
+    for (std::uint64_t key : keys) {
+        list.insert(key);
+    }
+    std::chrono::duration<double> loadTime = Clock::now() - loadStart;
+    long rssLoaded = currentRssKb();
+
+    std::vector<std::vector<std::uint64_t>> latencies(cfg.threads);
+    for (auto &l : latencies) {
+        l.reserve(ops.size() / cfg.threads + 1);
+    }
+    std::uint64_t checksum = 0;
+
+    auto replayStart = Clock::now();
+    if (cfg.mode == Mode::Single) {
+        checksum = replay(
+            list, ops, 0, 1, [] { return 0; }, latencies[0]);
+    } else {
+        std::mutex mutex;
+        std::vector<std::uint64_t> sums(cfg.threads);
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < cfg.threads; ++t) {
+            workers.emplace_back([&, t] {
+                sums[t] = replay(
+                    list, ops, t, cfg.threads,
+                    [&] { return std::unique_lock<std::mutex>(mutex); },
+                    latencies[t]);
+            });
+        }
+        for (auto &w : workers) {
+            w.join();
+        }
+        for (auto s : sums) {
+            checksum += s;
+        }
+    }
+    std::chrono::duration<double> replayTime = Clock::now() - replayStart;
+
+    std::vector<std::uint64_t> all;
+    all.reserve(ops.size());
+    for (auto &l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+
+    std::cout << "config:       p " << cfg.probability << ", max level "
+              << cfg.maxLevel << (cfg.lazyErase ? ", lazy erase" : "")
+              << (cfg.hashedLevels ? ", hashed levels" : "")
+              << ", mode "
+              << (cfg.mode == Mode::Single ? "single" : "mutex")
+              << ", threads " << cfg.threads << '\n';
+    std::cout << "load:         " << keys.size() << " keys in "
+              << loadTime.count() << " s\n";
+    std::cout << "replay:       " << ops.size() << " ops in "
+              << replayTime.count() << " s, "
+              << (replayTime.count() > 0 ? ops.size() / replayTime.count() : 0)
+              << " ops/s\n";
+    printLatencies(all);
+    std::cout << "final size:   " << list.size() << " keys\n";
+    std::cout << "memory KiB:   before load " << rssBefore << ", after load "
+              << rssLoaded << ", after replay " << currentRssKb() << ", peak "
+              << peakRssKb() << '\n';
+    std::cout << "checksum:     " << checksum << '\n';
+    return 0;
+}
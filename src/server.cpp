@@ -0,0 +1,317 @@
+#include "kv_protocol.hpp"
+#include "skip_list_map.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+volatile std::sig_atomic_t stopRequested = 0;
+
+void onSignal(int) { stopRequested = 1; }
+
+/// Bytes read from a socket per event before its requests are executed
+constexpr std::size_t kReadBudget = 256 * 1024;
+
+/// Pending output above which a connection is not read until it drains
+constexpr std::size_t kOutHighWater = 1024 * 1024;
+
+/**
+ * @brief State of one client connection.
+ *
+ * Incoming bytes are accumulated until whole requests are available; the
+ * responses to every request parsed from one read are appended to @c out and
+ * sent with a single write. A client that pipelines requests without
+ * reading the responses stops being read once kOutHighWater bytes of
+ * output are pending, so neither buffer grows without bound. A client that
+ * shuts down its sending side still gets the responses to every complete
+ * request it sent; the connection is closed once they are written.
+ */
+struct Connection {
+    explicit Connection(int fd) : fd(fd) {}
+
+    int fd;
+    std::vector<unsigned char> in;
+    std::vector<unsigned char> out;
+    std::size_t outSent = 0;
+    std::uint32_t events = EPOLLIN; ///< Events registered with epoll
+    bool readClosed = false;        ///< The peer sent end of file
+};
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * @brief Executes every complete request buffered for @p conn and queues
+ * the responses.
+ */
+void processRequests(SkipListMap<std::uint64_t, std::uint64_t> &map,
+                     Connection &conn) {
+    std::size_t count = conn.in.size() / kv::kRequestSize;
+    if (count == 0) {
+        return;
+    }
+    std::size_t outPos = conn.out.size();
+    conn.out.resize(outPos + count * kv::kResponseSize);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto req = kv::decodeRequest(conn.in.data() + i * kv::kRequestSize);
+        kv::encode(kv::execute(map, req),
+                   conn.out.data() + outPos + i * kv::kResponseSize);
+    }
+    conn.in.erase(conn.in.begin(),
+                  conn.in.begin() + count * kv::kRequestSize);
+}
+
+/**
+ * @brief Writes as much of the pending output as the socket accepts.
+ *
+ * @return false if the connection failed and must be closed.
+ */
+bool flushOutput(Connection &conn) {
+    while (conn.outSent < conn.out.size()) {
+        ssize_t n = send(conn.fd, conn.out.data() + conn.outSent,
+                         conn.out.size() - conn.outSent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return true;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        conn.outSent += static_cast<std::size_t>(n);
+    }
+    conn.out.clear();
+    conn.outSent = 0;
+    return true;
+}
+
+/**
+ * @brief Reads the socket into the input buffer until it is drained or
+ * kReadBudget bytes were read; the rest stays in the socket for the next
+ * event. End of file sets @c readClosed.
+ *
+ * @return false if an error occurred.
+ */
+bool readInput(Connection &conn) {
+    unsigned char buf[64 * 1024];
+    for (std::size_t total = 0; total < kReadBudget;) {
+        ssize_t n = recv(conn.fd, buf, sizeof(buf), 0);
+        if (n > 0) {
+            conn.in.insert(conn.in.end(), buf, buf + n);
+            total += static_cast<std::size_t>(n);
+            continue;
+        }
+        if (n == 0) {
+            conn.readClosed = true;
+            return true;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Waits for output space while responses are pending, and for input
+ * only while the peer may still send and the pending output is below
+ * kOutHighWater.
+ */
+void updateInterest(int epfd, Connection &conn) {
+    std::size_t pending = conn.out.size() - conn.outSent;
+    std::uint32_t events = 0;
+    if (!conn.readClosed && pending < kOutHighWater) {
+        events |= EPOLLIN;
+    }
+    if (pending > 0) {
+        events |= EPOLLOUT;
+    }
+    if (events == conn.events) {
+        return;
+    }
+    conn.events = events;
+    epoll_event ev{};
+    ev.events = events;
+    ev.data.fd = conn.fd;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, conn.fd, &ev);
+}
+
+/**
+ * @brief Accepts every pending connection.
+ *
+ * When the process or the system runs out of descriptors, the pending
+ * connection is accepted on the spare descriptor @p spareFd and closed
+ * at once; leaving it queued would keep the level-triggered listener
+ * readable and spin the event loop.
+ */
+void acceptClients(int epfd, int listenFd, int &spareFd,
+                   std::unordered_map<int, std::unique_ptr<Connection>>
+                       &connections) {
+    for (;;) {
+        int client = accept(listenFd, nullptr, nullptr);
+        if (client >= 0) {
+            setNonBlocking(client);
+            epoll_event cev{};
+            cev.events = EPOLLIN;
+            cev.data.fd = client;
+            epoll_ctl(epfd, EPOLL_CTL_ADD, client, &cev);
+            connections[client] = std::make_unique<Connection>(client);
+            continue;
+        }
+        if (errno == EINTR || errno == ECONNABORTED) {
+            continue;
+        }
+        if ((errno == EMFILE || errno == ENFILE) && spareFd >= 0) {
+            std::cerr << "accept: " << std::strerror(errno)
+                      << ", dropping a connection\n";
+            close(spareFd);
+            int rejected = accept(listenFd, nullptr, nullptr);
+            if (rejected >= 0) {
+                close(rejected);
+            }
+            spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            if (rejected >= 0) {
+                continue;
+            }
+        }
+        return;
+    }
+}
+
+int listenOn(const std::string &path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        close(fd);
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    std::strcpy(addr.sun_path, path.c_str());
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0 ||
+        listen(fd, SOMAXCONN) < 0 || !setNonBlocking(fd)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::string path = "/tmp/skip_list.sock";
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            path = argv[++i];
+        } else {
+            std::cerr << "Usage: skip_list_server [--socket PATH]\n";
+            return 1;
+        }
+    }
+
+    struct sigaction sa{};
+    sa.sa_handler = onSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    int listenFd = listenOn(path);
+    if (listenFd < 0) {
+        std::cerr << "Cannot listen on " << path << ": "
+                  << std::strerror(errno) << '\n';
+        return 1;
+    }
+    int epfd = epoll_create1(0);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listenFd;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listenFd, &ev);
+
+    int spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    SkipListMap<std::uint64_t, std::uint64_t> map;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    std::vector<epoll_event> events(256);
+
+    std::cout << "Listening on " << path << std::endl;
+    while (!stopRequested) {
+        int n = epoll_wait(epfd, events.data(),
+                           static_cast<int>(events.size()), -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "epoll_wait: " << std::strerror(errno) << '\n';
+            break;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptClients(epfd, listenFd, spareFd, connections);
+                continue;
+            }
+
+            auto found = connections.find(fd);
+            if (found == connections.end()) {
+                continue;
+            }
+            Connection &conn = *found->second;
+            bool alive = true;
+            if (!conn.readClosed &&
+                (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                alive = readInput(conn);
+                processRequests(map, conn);
+            }
+            if (!flushOutput(conn)) {
+                alive = false;
+            }
+            // A half-closed connection lives until its responses are sent
+            if (conn.readClosed && conn.out.empty()) {
+                alive = false;
+            }
+            if (!alive) {
+                epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+                close(fd);
+                connections.erase(found);
+                continue;
+            }
+            updateInterest(epfd, conn);
+        }
+    }
+
+    for (auto &[fd, conn] : connections) {
+        close(fd);
+    }
+    if (spareFd >= 0) {
+        close(spareFd);
+    }
+    close(epfd);
+    close(listenFd);
+    unlink(path.c_str());
+    std::cout << "Stopped with " << map.size() << " keys" << std::endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+/**
+ * @brief Counts the heap allocations of a test program.
+ *
+ * Replaces every non-aligned form of the global operator new and delete,
+ * so all of them allocate with malloc() and free with free(). Include it
+ * in one translation unit of a test only.
+ */
+namespace allocation_counter {
+
+inline std::atomic<std::size_t> count{0};
+
+inline void *allocate(std::size_t size) noexcept {
+    count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+/// Out of line, so that GCC does not see free() on a pointer it got from
+/// operator new and warn about mismatched deallocation
+[[gnu::noinline]] inline void release(void *p) noexcept { std::free(p); }
+
+} // namespace allocation_counter
+
+/**
+ * @brief Number of allocations made through operator new so far.
+ */
+inline std::size_t allocations() {
+    return allocation_counter::count.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) {
+    if (void *p = allocation_counter::allocate(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return allocation_counter::allocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return allocation_counter::allocate(size);
+}
+
+void operator delete(void *p) noexcept { allocation_counter::release(p); }
+void operator delete[](void *p) noexcept { allocation_counter::release(p); }
+
+void operator delete(void *p, std::size_t) noexcept {
+    allocation_counter::release(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    allocation_counter::release(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+    allocation_counter::release(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+    allocation_counter::release(p);
+}
+
+#endif // ALLOCATION_COUNTER_HPP
@@ -1,7 +1,12 @@
+#include "key_filter.hpp"
 #include "skip_list.hpp"
 #include <iostream>
 #include <string>
 #include <cassert>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 void demonstrateIntSkipList() {
     std::cout << "\n=== Целочисленный скип-лист ===\n";
@@ -33,6 +38,14 @@ void demonstrateIntSkipList() {
         std::cout << *it << ' ';
     }
     std::cout << '\n';
+
+    // Размер и нижняя граница
+    assert(list.size() == 5);
+    assert(*list.lower_bound(4) == 4);
+    assert(*list.lower_bound(7) == 9);
+    assert(list.lower_bound(10) == list.end());
+    std::cout << "Размер: " << list.size()
+              << ", lower_bound(7) = " << *list.lower_bound(7) << '\n';
 }
 
 void demonstrateStringSkipList() {
@@ -58,6 +71,79 @@ void demonstrateStringSkipList() {
     std::cout << '\n';
 }
 
+void demonstrateSortedInsert() {
+    std::cout << "\n=== Пакетная вставка отсортированных ключей ===\n";
+    SkipList<int> list;
+    list.insert(10);
+    list.insert(25);
+
+    std::vector<int> batch = {1, 5, 5, 10, 12, 20, 25, 30};
+    std::size_t inserted = list.insertSorted(batch.begin(), batch.end());
+    assert(inserted == 5 && list.size() == 7);
+
+    std::vector<int> expected = {1, 5, 10, 12, 20, 25, 30};
+    assert(std::equal(list.begin(), list.end(), expected.begin(),
+                      expected.end()));
+
+    std::vector<int> many;
+    for (int i = 0; i < 10000; i += 3) {
+        many.push_back(i);
+    }
+    list.insertSorted(many.begin(), many.end());
+    for (int i = 0; i < 10000; i += 3) {
+        assert(list.contains(i));
+    }
+    assert(std::is_sorted(list.begin(), list.end()));
+    std::cout << "После вставки пакетов: " << list.size() << " ключей\n";
+}
+
+void demonstrateLazyErase() {
+    std::cout << "\n=== Ленивое удаление ===\n";
+    SkipList<int> list;
+    list.setLazyErase(true);
+    for (int i = 1; i <= 10; ++i) {
+        list.insert(i);
+    }
+
+    bool erased3 = list.erase(3);
+    bool erased4 = list.erase(4);
+    bool erasedTwice = list.erase(4);
+    assert(erased3 && erased4);
+    assert(!erasedTwice); // уже помечен удалённым
+    assert(!list.contains(3));
+    assert(list.size() == 8);
+    assert(*list.lower_bound(3) == 5);
+    std::cout << "После ленивого удаления 3 и 4:\n";
+    list.printByLevels();
+
+    bool revived = list.insert(4).second;
+    assert(revived && list.contains(4)); // воскрешение узла
+
+    std::vector<int> expected = {1, 2, 4, 5, 6, 7, 8, 9, 10};
+    assert(std::equal(list.begin(), list.end(), expected.begin(),
+                      expected.end()));
+
+    std::size_t purged = list.purge();
+    std::size_t purgedAgain = list.purge();
+    assert(purged == 1 && purgedAgain == 0);
+    assert(std::equal(list.begin(), list.end(), expected.begin(),
+                      expected.end()));
+
+    // Массовое удаление с автоматической очисткой
+    for (int i = 0; i < 5000; ++i) {
+        list.insert(100 + i);
+    }
+    for (int i = 0; i < 5000; i += 2) {
+        list.erase(100 + i);
+    }
+    list.setLazyErase(false);
+    assert(list.size() == 9 + 2500);
+    for (int i = 0; i < 5000; ++i) {
+        assert(list.contains(100 + i) == (i % 2 == 1));
+    }
+    std::cout << "После очистки: " << list.size() << " ключей\n";
+}
+
 void demonstrateMoveSemantics() {
     std::cout << "\n=== Перемещение ===\n";
     SkipList<int> list1;
@@ -72,12 +158,183 @@ void demonstrateMoveSemantics() {
     list3 = std::move(list2); // перемещающее присваивание
     std::cout << "list3 после присваивания:\n";
     list3.printByLevels();
+
+    // Перемещённый список пуст и снова пригоден к работе
+    assert(list1.empty() && list1.begin() == list1.end());
+    list1.insert(5);
+    assert(list1.contains(5) && list1.size() == 1);
+}
+
+void demonstrateLightweightInstances() {
+    std::cout << "\n=== Лёгкие пустые списки ===\n";
+    static_assert(sizeof(SkipList<int>) <= 64,
+                  "an empty list must stay within one cache line");
+
+    SkipList<int> list;
+    assert(list.begin() == list.end());
+    assert(!list.contains(1) && list.find(1) == list.end());
+    assert(list.lower_bound(1) == list.end());
+    bool erased = list.erase(1);
+    std::size_t cut = list.eraseBelow(10, [](int) {});
+    assert(!erased && cut == 0);
+    auto finger = list.finger();
+    auto none = list.seek(finger, 0);
+    assert(none == list.end());
+    list.printByLevels();
+
+    std::vector<int> batch;
+    std::size_t inserted = list.insertSorted(batch.begin(), batch.end());
+    assert(inserted == 0);
+    list.insert(3);
+    auto first = list.seek(finger, 0);
+    assert(*first == 3);
+
+    // Миллион пустых списков не выделяет памяти под узлы
+    std::vector<SkipList<int>> many(1000000);
+    for (std::size_t i = 0; i < many.size(); i += 1000) {
+        many[i].insert(static_cast<int>(i));
+    }
+    assert(many[2000].contains(2000) && many[2001].empty());
+    std::cout << "sizeof(SkipList<int>) = " << sizeof(SkipList<int>)
+              << " байт\n";
+}
+
+void demonstrateHashedLevels() {
+    std::cout << "\n=== Высоты из хеша ключа ===\n";
+    std::vector<int> keys(2000);
+    for (int i = 0; i < 2000; ++i) {
+        keys[i] = i * 7;
+    }
+
+    SkipList<int> ascending(0.5, 32, LevelMode::Hashed);
+    ascending.insertSorted(keys.begin(), keys.end());
+
+    std::mt19937 rng(11);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    SkipList<int> shuffled(0.5, 32, LevelMode::Hashed);
+    for (int key : keys) {
+        shuffled.insert(key);
+    }
+    shuffled.insert(1);
+    assert(!ascending.sameStructure(shuffled));
+    shuffled.erase(1);
+
+    // Одинаковый набор ключей даёт одинаковую структуру
+    assert(ascending.sameStructure(shuffled));
+    assert(std::equal(ascending.begin(), ascending.end(), shuffled.begin(),
+                      shuffled.end()));
+
+    SkipList<std::string> words(0.25, 16, LevelMode::Hashed);
+    SkipList<std::string> reversed(0.25, 16, LevelMode::Hashed);
+    for (const char *w : {"alpha", "beta", "gamma", "delta", "epsilon"}) {
+        words.insert(w);
+    }
+    for (const char *w : {"epsilon", "delta", "gamma", "beta", "alpha"}) {
+        reversed.insert(w);
+    }
+    assert(words.sameStructure(reversed));
+    words.printByLevels();
+
+    // Без std::hash хешированные высоты недоступны, даже с NDEBUG
+    struct Unhashable {
+        int v;
+        bool operator<(const Unhashable &o) const { return v < o.v; }
+    };
+    bool rejected = false;
+    try {
+        SkipList<Unhashable> list(0.5, 32, LevelMode::Hashed);
+    } catch (const std::invalid_argument &) {
+        rejected = true;
+    }
+    assert(rejected);
+}
+
+void demonstrateFilteredScan() {
+    std::cout << "\n=== Просмотр с фильтром ===\n";
+    SkipList<int> numbers;
+    for (int i = 0; i < 5000; ++i) {
+        numbers.insert(i);
+    }
+    numbers.setLazyErase(true);
+    for (int i = 0; i < 5000; i += 3) {
+        numbers.erase(i); // Надгробия пропускаются при сборе пакета
+    }
+
+    auto filter = KeyFilter<int>().range(100, 3999).modulo(8, 5);
+    std::vector<int> found;
+    std::size_t count = numbers.scanIf(
+        50, 4500, filter, [&](int key) { found.push_back(key); });
+    std::vector<int> expected;
+    for (int key : numbers) {
+        if (key >= 100 && key < 4000 && key % 8 == 5) {
+            expected.push_back(key);
+        }
+    }
+    assert(found == expected && count == expected.size());
+
+    // Не степень двойки и условие на биты: остаток по 10, чётная сотня
+    auto odd = KeyFilter<int>().modulo(10, 7).bits(0x100, 0);
+    count = numbers.scanIf(0, 5000, odd, [](int key) {
+        assert(key % 10 == 7 && !(key & 0x100));
+    });
+    assert(count > 0);
+    assert(numbers.scanIf(10, 10, filter, [](int) { assert(false); }) == 0);
+
+    // Нулевой модуль не добавляет условия
+    auto any = KeyFilter<int>().range(0, 99).modulo(0, 5);
+    assert(numbers.scanIf(0, 5000, any, [](int) {}) == 66);
+
+    // Произвольный предикат на строках
+    SkipList<std::string> words;
+    for (const char *w : {"apple", "avocado", "banana", "cherry", "apricot"}) {
+        words.insert(w);
+    }
+    std::vector<std::string> seven;
+    words.scanIf(
+        "a", "b", [](const std::string &w) { return w.size() == 7; },
+        [&](const std::string &w) { seven.push_back(w); });
+    assert((seven == std::vector<std::string>{"apricot", "avocado"}));
+    std::cout << "Найдено ключей: " << found.size() << "\n";
+}
+
+void demonstrateRangeExport() {
+    std::cout << "\n=== Выгрузка диапазона в буфер ===\n";
+    SkipList<int> numbers;
+    for (int i = 0; i < 1000; ++i) {
+        numbers.insert(i * 3);
+    }
+    numbers.setLazyErase(true);
+    numbers.erase(30);
+
+    std::vector<int> buffer(16);
+    std::size_t n = numbers.exportRange(20, 60, buffer);
+    assert(n == 12 && buffer[0] == 21 && buffer[2] == 27 && buffer[3] == 33);
+    assert(numbers.exportRange(5000, 6000, buffer) == 0);
+
+    // Порции по 16 ключей, последняя неполная
+    std::vector<int> all;
+    std::size_t chunks = 0;
+    std::size_t total = numbers.exportChunks(
+        0, 3000, buffer, [&](std::span<const int> chunk) {
+            all.insert(all.end(), chunk.begin(), chunk.end());
+            ++chunks;
+        });
+    assert(total == 999 && all.size() == 999 && chunks == 63);
+    assert(std::equal(all.begin(), all.end(), numbers.begin()));
+    std::cout << "Выгружено " << total << " ключей за " << chunks
+              << " порции\n";
 }
 
 int main() {
     demonstrateIntSkipList();
     demonstrateStringSkipList();
+    demonstrateSortedInsert();
+    demonstrateLazyErase();
     demonstrateMoveSemantics();
+    demonstrateLightweightInstances();
+    demonstrateHashedLevels();
+    demonstrateFilteredScan();
+    demonstrateRangeExport();
 
     std::cout << "\nВсе тесты пройдены успешно.\n";
     return 0;
@@ -0,0 +1,140 @@
+#include "b_skip_list.hpp"
+#include "key_filter.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+void demonstrateRandomOps() {
+    std::cout << "\n=== Случайные операции против std::set ===\n";
+    // Маленькие блоки и частое продвижение: много разбиений и слияний
+    BSkipList<std::uint64_t, 4> small(0.5);
+    BSkipList<std::uint64_t> wide;
+    std::set<std::uint64_t> reference;
+    std::mt19937_64 rng(7);
+    for (int step = 0; step < 200000; ++step) {
+        std::uint64_t key = rng() % 5000;
+        switch (rng() % 4) {
+        case 0: {
+            bool erased = reference.erase(key) == 1;
+            bool fromSmall = small.erase(key);
+            bool fromWide = wide.erase(key);
+            assert(fromSmall == erased && fromWide == erased);
+            break;
+        }
+        case 1: {
+            auto it = small.lower_bound(key);
+            auto expected = reference.lower_bound(key);
+            assert((it == small.end()) == (expected == reference.end()));
+            assert(it == small.end() || *it == *expected);
+            break;
+        }
+        default:
+            bool inserted = reference.insert(key).second;
+            bool intoSmall = small.insert(key);
+            bool intoWide = wide.insert(key);
+            assert(intoSmall == inserted && intoWide == inserted);
+        }
+        assert(small.size() == reference.size());
+    }
+    std::vector<std::uint64_t> expected(reference.begin(), reference.end());
+    assert(std::vector<std::uint64_t>(small.begin(), small.end()) == expected);
+    assert(std::vector<std::uint64_t>(wide.begin(), wide.end()) == expected);
+    for (std::uint64_t key = 0; key < 5000; ++key) {
+        assert(small.contains(key) == (reference.count(key) == 1));
+    }
+    std::cout << "Ключей: " << small.size() << ", уровней: " << small.levels()
+              << "\n";
+}
+
+void demonstrateSequentialKeys() {
+    std::cout << "\n=== Возрастающие и убывающие ключи ===\n";
+    BSkipList<int, 16> list;
+    for (int i = 0; i < 100000; ++i) {
+        bool inserted = list.insert(i);
+        assert(inserted);
+    }
+    for (int i = -1; i > -100000; --i) {
+        bool inserted = list.insert(i);
+        assert(inserted);
+    }
+    bool duplicate = list.insert(0);
+    assert(!duplicate);
+    int expected = -99999;
+    for (int key : list) {
+        assert(key == expected);
+        ++expected;
+    }
+    // Удаление всех ключей сворачивает уровни
+    for (int i = -99999; i < 100000; ++i) {
+        bool erased = list.erase(i);
+        assert(erased);
+    }
+    assert(list.empty() && list.levels() == 1);
+    assert(list.begin() == list.end() && !list.contains(5));
+    std::cout << "Вставлено и удалено 199999 ключей\n";
+}
+
+void demonstrateStrings() {
+    std::cout << "\n=== Строковые ключи ===\n";
+    BSkipList<std::string, 8> words;
+    for (const char *w : {"pear", "apple", "fig", "plum", "kiwi", "apple"}) {
+        words.insert(w);
+    }
+    assert(words.size() == 5);
+    assert(*words.lower_bound("b") == "fig");
+    assert(words.lower_bound("q") == words.end());
+    bool erased = words.erase("fig");
+    assert(erased && *words.lower_bound("b") == "kiwi");
+    for (const std::string &w : words) {
+        std::cout << w << " ";
+    }
+    std::cout << "\n";
+}
+
+void demonstrateFilteredScan() {
+    std::cout << "\n=== Просмотр с фильтром по блокам ===\n";
+    BSkipList<std::uint64_t, 16> list;
+    std::set<std::uint64_t> reference;
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 20000; ++i) {
+        std::uint64_t key = rng() % 100000;
+        list.insert(key);
+        reference.insert(key);
+    }
+    auto filter = KeyFilter<std::uint64_t>().bits(0xF0, 0x30).modulo(3, 1);
+    for (auto [lo, hi] : {std::pair<std::uint64_t, std::uint64_t>{0, 100000},
+                          {123, 45678},
+                          {500, 501},
+                          {99999, 200000}}) {
+        std::vector<std::uint64_t> found;
+        list.scanIf(lo, hi, filter,
+                    [&](std::uint64_t key) { found.push_back(key); });
+        std::vector<std::uint64_t> expected;
+        for (auto it = reference.lower_bound(lo);
+             it != reference.end() && *it < hi; ++it) {
+            if ((*it & 0xF0) == 0x30 && *it % 3 == 1) {
+                expected.push_back(*it);
+            }
+        }
+        assert(found == expected);
+    }
+    std::size_t all =
+        list.scanIf(0, 100000, [](std::uint64_t) { return true; },
+                    [](std::uint64_t) {});
+    assert(all == reference.size());
+    std::cout << "Фильтр совпадает с полным перебором\n";
+}
+
+int main() {
+    demonstrateRandomOps();
+    demonstrateSequentialKeys();
+    demonstrateStrings();
+    demonstrateFilteredScan();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
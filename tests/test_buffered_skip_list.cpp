@@ -0,0 +1,154 @@
+#include "buffered_skip_list.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+void demonstrateBufferedWrites() {
+    std::cout << "\n=== Буферизованные записи в одном потоке ===\n";
+    BufferedSkipList<std::uint64_t> list(64, 2);
+    std::set<std::uint64_t> reference;
+    std::mt19937_64 rng(8);
+    for (int step = 0; step < 30000; ++step) {
+        std::uint64_t key = rng() % 1000;
+        switch (rng() % 3) {
+        case 0:
+            list.erase(key);
+            reference.erase(key);
+            break;
+        case 1:
+            // Чтение видит и буфер, и основной список
+            assert(list.contains(key) == (reference.count(key) == 1));
+            break;
+        default:
+            list.insert(key);
+            reference.insert(key);
+        }
+    }
+    assert(list.merges() > 0);
+    assert(list.size() == reference.size());
+
+    std::vector<std::uint64_t> keys;
+    list.forEach([&](std::uint64_t key) { keys.push_back(key); });
+    assert(keys == std::vector<std::uint64_t>(reference.begin(),
+                                              reference.end()));
+    std::cout << "Ключей: " << keys.size() << ", слияний: " << list.merges()
+              << "\n";
+}
+
+void demonstrateLastWriteWins() {
+    std::cout << "\n=== Последняя запись побеждает ===\n";
+    BufferedSkipList<int> list(1000, 4);
+    list.insert(1);
+    list.erase(1);
+    list.insert(1);
+    list.insert(2);
+    list.erase(2);
+    assert(list.contains(1) && !list.contains(2));
+
+    list.flush();
+    list.erase(1); // В буфере, а ключ уже в списке
+    assert(!list.contains(1));
+    list.flush();
+    assert(!list.contains(1) && list.size() == 0);
+    std::cout << "Порядок операций над одним ключом сохраняется\n";
+}
+
+void demonstrateConcurrentIngest() {
+    std::cout << "\n=== Параллельная загрузка ===\n";
+    BufferedSkipList<std::uint64_t> list(128, 4);
+    constexpr unsigned kThreads = 4;
+    constexpr std::uint64_t kPerThread = 50000;
+
+    std::vector<std::thread> writers;
+    for (unsigned t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&list, t] {
+            for (std::uint64_t i = 0; i < kPerThread; ++i) {
+                std::uint64_t key = i * kThreads + t;
+                list.insert(key);
+                // Свои записи видны сразу, до слияния
+                assert(list.contains(key));
+                if (i % 4 == 0) {
+                    list.erase(key);
+                    assert(!list.contains(key));
+                }
+            }
+        });
+    }
+    for (std::thread &w : writers) {
+        w.join();
+    }
+
+    assert(list.size() == kThreads * kPerThread * 3 / 4);
+    std::uint64_t count = 0;
+    list.forEach([&](std::uint64_t key) {
+        assert((key / kThreads) % 4 != 0);
+        ++count;
+    });
+    assert(count == list.size());
+    std::cout << "Загружено " << count << " ключей за " << list.merges()
+              << " слияний\n";
+}
+
+void demonstrateSharedKeys() {
+    std::cout << "\n=== Два потока пишут одни и те же ключи ===\n";
+    BufferedSkipList<std::uint64_t> list(8, 2);
+    constexpr std::uint64_t kKeys = 3000;
+    // Шаг s ключа k делает поток s % 2: чётные шаги вставляют, нечётные
+    // удаляют, и каждый шаг ждёт предыдущего, так что порядок записей
+    // одного ключа задан, а слияния идут между ними
+    std::vector<std::atomic<int>> progress(kKeys);
+    auto steps = [](std::uint64_t key) {
+        return 2 + static_cast<int>(key % 2);
+    };
+    auto writer = [&](int parity) {
+        for (std::uint64_t key = 0; key < kKeys; ++key) {
+            for (int step = parity; step < steps(key); step += 2) {
+                while (progress[key].load(std::memory_order_acquire) != step) {
+                    std::this_thread::yield();
+                }
+                if (step % 2 == 0) {
+                    list.insert(key);
+                } else {
+                    list.erase(key);
+                }
+                progress[key].store(step + 1, std::memory_order_release);
+            }
+        }
+    };
+    std::atomic<bool> done{false};
+    std::thread flusher([&] {
+        while (!done.load()) {
+            list.flush();
+            std::this_thread::yield();
+        }
+    });
+    std::thread inserter(writer, 0);
+    std::thread eraser(writer, 1);
+    inserter.join();
+    eraser.join();
+    done = true;
+    flusher.join();
+
+    // Побеждает последняя запись: остаются ключи с нечётным числом шагов
+    for (std::uint64_t key = 0; key < kKeys; ++key) {
+        assert(list.contains(key) == (steps(key) % 2 == 1));
+    }
+    assert(list.size() == kKeys / 2);
+    std::cout << "Слияний: " << list.merges() << ", ключей: " << list.size()
+              << "\n";
+}
+
+int main() {
+    demonstrateBufferedWrites();
+    demonstrateLastWriteWins();
+    demonstrateConcurrentIngest();
+    demonstrateSharedKeys();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
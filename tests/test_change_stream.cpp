@@ -0,0 +1,86 @@
+#include "change_stream.hpp"
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+bool sameKeys(const SkipList<int> &a, const SkipList<int> &b) {
+    auto it = b.begin();
+    for (int key : a) {
+        if (it == b.end() || *it != key) {
+            return false;
+        }
+        ++it;
+    }
+    return it == b.end();
+}
+
+void demonstrateSingleThreadReplay() {
+    std::cout << "\n=== Поток изменений в одном потоке ===\n";
+    SkipList<int> leader;
+    SkipList<int> follower;
+    ChangeStream<int> stream(16);
+    leader.setChangeSink(&stream);
+
+    for (int x : {5, 3, 8, 1}) {
+        leader.insert(x);
+    }
+    leader.insert(5); // повтор не попадает в поток
+    leader.erase(3);
+    leader.erase(42); // отсутствующий ключ тоже
+
+    assert(stream.producedSeq() == 5);
+    std::size_t applied = stream.applyTo(follower);
+    assert(applied == 5 && stream.consumedSeq() == 5);
+    assert(sameKeys(leader, follower));
+
+    std::cout << "Ведомый список: ";
+    for (int x : follower) {
+        std::cout << x << ' ';
+    }
+    std::cout << '\n';
+}
+
+void demonstrateConcurrentReplay() {
+    std::cout << "\n=== Поток изменений между потоками ===\n";
+    SkipList<int> leader;
+    SkipList<int> follower;
+    ChangeStream<int> stream(1024);
+    leader.setChangeSink(&stream);
+
+    std::atomic<bool> done{false};
+    std::thread consumer([&] {
+        while (!done.load() || stream.consumedSeq() < stream.producedSeq()) {
+            if (stream.applyTo(follower, 256) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> keys(0, 5000);
+    for (int i = 0; i < 100000; ++i) {
+        if (rng() % 3 == 0) {
+            leader.erase(keys(rng));
+        } else {
+            leader.insert(keys(rng));
+        }
+    }
+    done.store(true);
+    consumer.join();
+
+    assert(sameKeys(leader, follower));
+    assert(follower.size() == leader.size());
+    std::cout << "Применено событий: " << stream.consumedSeq()
+              << ", ключей у ведомого: " << follower.size() << '\n';
+}
+
+int main() {
+    demonstrateSingleThreadReplay();
+    demonstrateConcurrentReplay();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "checkpoint.hpp"
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+bool sameKeys(const SkipList<std::uint64_t> &a,
+              const SkipList<std::uint64_t> &b) {
+    auto it = b.begin();
+    for (auto key : a) {
+        if (it == b.end() || *it != key) {
+            return false;
+        }
+        ++it;
+    }
+    return it == b.end();
+}
+
+void demonstrateQuiescentCheckpoint() {
+    std::cout << "\n=== Контрольная точка без записей ===\n";
+    const std::string path = "checkpoint_quiet.bin";
+    SkipList<std::uint64_t> list;
+    for (std::uint64_t i = 0; i < 10000; ++i) {
+        list.insert(i * 7);
+    }
+
+    std::mutex mutex;
+    Checkpointer<std::uint64_t> ckpt(list, mutex, path, 100);
+    ckpt.start();
+    // Вызов вне assert: с NDEBUG поток всё равно должен быть дождан
+    bool written = ckpt.wait();
+    assert(written);
+    assert(ckpt.imageRecords() == 10000);
+    assert(ckpt.logRecords() == 0);
+
+    SkipList<std::uint64_t> restored;
+    bool loaded = loadCheckpoint(path, restored);
+    assert(loaded && sameKeys(list, restored));
+    std::cout << "Восстановлено ключей: " << restored.size() << '\n';
+    std::remove(path.c_str());
+}
+
+void demonstrateCheckpointUnderWrites() {
+    std::cout << "\n=== Контрольная точка при работающих записях ===\n";
+    const std::string path = "checkpoint_live.bin";
+    SkipList<std::uint64_t> list;
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 50000; ++i) {
+        list.insert(rng() % 100000);
+    }
+
+    std::mutex mutex;
+    Checkpointer<std::uint64_t> ckpt(list, mutex, path, 64);
+    ckpt.start();
+
+    // Писатель останавливается, как только захват изменений завершён:
+    // после этого список совпадает с содержимым контрольной точки.
+    std::thread writer([&] {
+        std::mt19937_64 wrng(11);
+        for (;;) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!ckpt.capturing()) {
+                break;
+            }
+            std::uint64_t key = wrng() % 100000;
+            if (wrng() % 2) {
+                list.insert(key);
+            } else {
+                list.erase(key);
+            }
+        }
+    });
+    bool written = ckpt.wait();
+    assert(written);
+    writer.join();
+
+    SkipList<std::uint64_t> restored;
+    bool loaded = loadCheckpoint(path, restored);
+    assert(loaded && sameKeys(list, restored));
+    std::cout << "Записей образа: " << ckpt.imageRecords()
+              << ", записей журнала: " << ckpt.logRecords() << '\n';
+    std::remove(path.c_str());
+}
+
+void demonstrateIoBackends() {
+    std::cout << "\n=== Сохранение и загрузка разными бэкендами ===\n";
+    SkipList<std::uint64_t> list;
+    std::mt19937_64 rng(5);
+    for (int i = 0; i < 300000; ++i) {
+        list.insert(rng());
+    }
+
+    const IoBackend backends[] = {IoBackend::Blocking, IoBackend::Threaded,
+                                  IoBackend::Uring};
+    const char *names[] = {"blocking", "threaded", "io_uring"};
+    for (int w = 0; w < 3; ++w) {
+        const std::string path = "checkpoint_frozen.bin";
+        bool saved = saveCheckpoint(list, path, backends[w]);
+        assert(saved);
+        for (int r = 0; r < 3; ++r) {
+            SkipList<std::uint64_t> restored;
+            bool loaded = loadCheckpoint(path, restored, backends[r]);
+            assert(loaded && sameKeys(list, restored));
+        }
+        std::cout << "Запись через " << names[w]
+                  << " читается всеми бэкендами\n";
+        std::remove(path.c_str());
+    }
+
+    // Uring работает как Threaded там, где io_uring недоступен
+    IoBackend uring = effectiveBackend(IoBackend::Uring);
+    assert(uring == IoBackend::Uring || uring == IoBackend::Threaded);
+    assert(effectiveBackend(IoBackend::Blocking) == IoBackend::Blocking);
+    std::cout << "io_uring " << (uring == IoBackend::Uring ? "" : "не ")
+              << "доступен\n";
+
+    SkipList<std::uint64_t> none;
+    bool loaded = loadCheckpoint("no_such_checkpoint.bin", none);
+    assert(!loaded);
+}
+
+void demonstrateReadErrors() {
+    std::cout << "\n=== Ошибка чтения ===\n";
+    // Каталог открывается на чтение, но read() из него завершается EISDIR
+    const std::string dir = "checkpoint_unreadable";
+    std::filesystem::create_directory(dir);
+    std::ofstream(dir + "/entry") << "x";
+
+    const IoBackend backends[] = {IoBackend::Blocking, IoBackend::Threaded,
+                                  IoBackend::Uring};
+    for (IoBackend backend : backends) {
+        auto reader = makeBlockReader(dir, backend, 4096, 4);
+        assert(reader);
+        bool empty = reader->next().empty();
+        assert(empty && !reader->ok());
+        SkipList<std::uint64_t> restored;
+        bool loaded = loadCheckpoint(dir, restored, backend);
+        assert(!loaded);
+    }
+    std::filesystem::remove_all(dir);
+    std::cout << "Все бэкенды сообщают об ошибке, а не зависают\n";
+}
+
+int main() {
+    demonstrateQuiescentCheckpoint();
+    demonstrateCheckpointUnderWrites();
+    demonstrateIoBackends();
+    demonstrateReadErrors();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "concurrent_skip_list.hpp"
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+void demonstrateSingleThread() {
+    std::cout << "\n=== Конкурентный скип-лист в одном потоке ===\n";
+    ConcurrentSkipList<std::uint64_t> list;
+    std::set<std::uint64_t> reference;
+    std::mt19937_64 rng(5);
+    for (int step = 0; step < 20000; ++step) {
+        std::uint64_t key = rng() % 2000;
+        switch (rng() % 3) {
+        case 0: {
+            bool erased = reference.erase(key) == 1;
+            bool result = list.erase(key);
+            assert(result == erased);
+            break;
+        }
+        case 1:
+            assert(list.contains(key) == (reference.count(key) == 1));
+            break;
+        default:
+            bool inserted = reference.insert(key).second;
+            bool result = list.insert(key);
+            assert(result == inserted);
+        }
+        if (step % 5000 == 0) {
+            list.rebuildIndex();
+        }
+    }
+    assert(list.size() == reference.size());
+
+    std::vector<std::uint64_t> keys;
+    list.forEach([&](std::uint64_t key) { keys.push_back(key); });
+    assert(keys == std::vector<std::uint64_t>(reference.begin(),
+                                              reference.end()));
+
+    list.rebuildIndex();
+    assert(list.indexLevels() > 3);
+    for (std::uint64_t key = 0; key < 2000; ++key) {
+        assert(list.contains(key) == (reference.count(key) == 1));
+    }
+    std::cout << "Ключей: " << list.size() << ", уровней индекса: "
+              << list.indexLevels() << "\n";
+}
+
+void demonstrateConcurrentWriters() {
+    std::cout << "\n=== Параллельные вставки и удаления ===\n";
+    ConcurrentSkipList<std::uint64_t> list;
+    constexpr unsigned kThreads = 4;
+    constexpr std::uint64_t kPerThread = 20000;
+
+    // Каждый поток вставляет свои ключи, перемешанные с чужими, и удаляет
+    // нечётные из них; читатель всё это время ищет ключи
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        std::mt19937_64 rng(1);
+        while (!done.load()) {
+            list.contains(rng() % (kThreads * kPerThread));
+        }
+    });
+    std::vector<std::thread> writers;
+    for (unsigned t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&list, t] {
+            for (std::uint64_t i = 0; i < kPerThread; ++i) {
+                bool inserted = list.insert(i * kThreads + t);
+                assert(inserted);
+            }
+            for (std::uint64_t i = 1; i < kPerThread; i += 2) {
+                bool erased = list.erase(i * kThreads + t);
+                bool again = list.erase(i * kThreads + t);
+                assert(erased && !again);
+            }
+        });
+    }
+    for (std::thread &w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+
+    assert(list.size() == kThreads * kPerThread / 2);
+    std::uint64_t expected = 0;
+    list.forEach([&](std::uint64_t key) {
+        // Остаются ключи с чётным номером внутри своего потока
+        while ((expected / kThreads) % 2 == 1) {
+            ++expected;
+        }
+        assert(key == expected);
+        ++expected;
+    });
+    std::cout << "Осталось ключей: " << list.size()
+              << ", перестроений индекса в фоне: " << list.rebuilds() << "\n";
+}
+
+void demonstrateContendedKeys() {
+    std::cout << "\n=== Гонки за одни и те же ключи ===\n";
+    ConcurrentSkipList<std::uint64_t> list;
+    constexpr unsigned kThreads = 4;
+    std::vector<std::int64_t> balance(kThreads, 0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&list, &balance, t] {
+            std::mt19937_64 rng(t);
+            for (int step = 0; step < 50000; ++step) {
+                std::uint64_t key = rng() % 64;
+                if (rng() % 2) {
+                    balance[t] += list.insert(key);
+                } else {
+                    balance[t] -= list.erase(key);
+                }
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    // Успешные вставки минус успешные удаления равны числу ключей
+    std::int64_t total = 0;
+    for (std::int64_t b : balance) {
+        total += b;
+    }
+    std::size_t count = 0;
+    list.forEach([&](std::uint64_t) { ++count; });
+    assert(count == list.size());
+    assert(static_cast<std::int64_t>(count) == total);
+    std::cout << "Итог гонок сходится: " << count << " ключей\n";
+}
+
+void demonstrateReclaimWithoutRebuild() {
+    std::cout << "\n=== Освобождение узлов без перестроения ===\n";
+    ConcurrentSkipList<std::uint64_t> list;
+    for (std::uint64_t key = 0; key < 100000; ++key) {
+        list.insert(key);
+    }
+    list.rebuildIndex();
+    std::size_t rebuilds = list.rebuilds();
+    std::size_t freed = list.freedNodes();
+
+    // Удаляется 1% ключей: индекс не перестраивается, но узлы высоты 1
+    // освобождаются фоновым потоком
+    for (std::uint64_t key = 0; key < 100000; key += 100) {
+        bool erased = list.erase(key);
+        assert(erased);
+    }
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (list.freedNodes() == freed &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    assert(list.freedNodes() > freed);
+    assert(list.freedNodes() - freed < 1000);
+    assert(list.rebuilds() == rebuilds);
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        assert(list.contains(key) == (key % 100 != 0));
+    }
+
+    // Перестроение освобождает и остальные удалённые узлы
+    list.rebuildIndex();
+    assert(list.freedNodes() - freed == 1000);
+    std::cout << "Освобождено без перестроения узлов высоты 1, остальные - "
+                 "при перестроении\n";
+}
+
+int main() {
+    demonstrateSingleThread();
+    demonstrateConcurrentWriters();
+    demonstrateContendedKeys();
+    demonstrateReclaimWithoutRebuild();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "allocation_counter.hpp"
+#include "intrusive_skip_list.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+struct Order {
+    std::uint64_t id;
+    std::int64_t price;
+    SkipListHook<Order> byId;
+    SkipListHook<Order, 8> byPrice;
+};
+
+struct IdOf {
+    const std::uint64_t &operator()(const Order &o) const { return o.id; }
+};
+
+struct PriceOf {
+    std::pair<std::int64_t, std::uint64_t> operator()(const Order &o) const {
+        return {o.price, o.id};
+    }
+};
+
+using OrdersById = IntrusiveSkipList<Order, &Order::byId, IdOf>;
+using OrdersByPrice = IntrusiveSkipList<Order, &Order::byPrice, PriceOf>;
+
+void demonstrateIntrusiveLinks() {
+    std::cout << "\n=== Интрузивный скип-лист ===\n";
+    std::vector<Order> pool(10000);
+    std::mt19937 rng(4);
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        pool[i].id = i * 2 + 1;
+        pool[i].price = 1000 + static_cast<std::int64_t>(rng() % 200);
+    }
+    std::shuffle(pool.begin(), pool.end(), rng);
+
+    OrdersById byId;
+    OrdersByPrice byPrice;
+    // Связывание объектов не выделяет памяти
+    std::size_t before = allocations();
+    for (Order &o : pool) {
+        bool linkedById = byId.insert(o);
+        bool linkedByPrice = byPrice.insert(o);
+        assert(linkedById && linkedByPrice);
+    }
+    assert(allocations() == before);
+    std::cout << "Связано " << byId.size() << " объектов в два списка без "
+              << "выделений памяти\n";
+
+    // Один объект в двух списках с разными ключами
+    std::uint64_t lastId = 0;
+    for (const Order &o : byId) {
+        assert(o.id > lastId);
+        lastId = o.id;
+    }
+    std::pair<std::int64_t, std::uint64_t> lastPrice{0, 0};
+    for (const Order &o : byPrice) {
+        assert(PriceOf{}(o) > lastPrice);
+        lastPrice = PriceOf{}(o);
+    }
+
+    Order twin{pool[0].id, 0, {}, {}};
+    bool twinLinked = byId.insert(twin);
+    assert(!twinLinked && !twin.byId.linked());
+
+    Order *found = byId.find(21);
+    assert(found && found->id == 21);
+    assert(!byId.find(22) && byId.lower_bound(22)->id == 23);
+    bool unlinked = byId.erase(*found);
+    bool unlinkedTwice = byId.erase(*found);
+    assert(unlinked && !unlinkedTwice);
+    unlinked = byPrice.erase(*found);
+    assert(unlinked);
+    unlinked = byId.erase(23);
+    unlinkedTwice = byId.erase(23);
+    assert(unlinked && !unlinkedTwice);
+    assert(byId.size() == pool.size() - 2);
+    assert(byPrice.size() == pool.size() - 1);
+    assert(allocations() == before);
+
+    byId.clear();
+    assert(byId.empty() && !pool[5].byId.linked() && pool[5].byPrice.linked());
+    byPrice.clear();
+    std::cout << "Удаление и очистка не трогают кучу\n";
+}
+
+int main() {
+    demonstrateIntrusiveLinks();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "kv_protocol.hpp"
+#include "skip_list_map.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+void demonstrateRoundTrip() {
+    std::cout << "\n=== Кодирование запросов и ответов ===\n";
+    const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+    const kv::Request requests[] = {{kv::Op::Get, 0, 0},
+                                    {kv::Op::Put, max, 42},
+                                    {kv::Op::Del, 0x0102030405060708ull, max}};
+    for (const auto &req : requests) {
+        unsigned char frame[kv::kRequestSize];
+        std::fill(std::begin(frame), std::end(frame), 0xff);
+        kv::encode(req, frame);
+        // Байты выравнивания обнуляются
+        for (std::size_t i = 1; i < 8; ++i) {
+            assert(frame[i] == 0);
+        }
+        kv::Request back = kv::decodeRequest(frame);
+        assert(back.op == req.op && back.key == req.key &&
+               back.value == req.value);
+    }
+
+    const kv::Response responses[] = {{kv::Status::Ok, max},
+                                      {kv::Status::NotFound, 0},
+                                      {kv::Status::BadRequest, 7}};
+    for (const auto &resp : responses) {
+        unsigned char frame[kv::kResponseSize];
+        kv::encode(resp, frame);
+        kv::Response back = kv::decodeResponse(frame);
+        assert(back.status == resp.status && back.value == resp.value);
+    }
+    std::cout << "Запросы и ответы восстанавливаются без потерь\n";
+}
+
+void demonstratePipeline() {
+    std::cout << "\n=== Конвейер запросов ===\n";
+    // Пачка запросов разбирается из одного буфера, как на сервере
+    const kv::Request batch[] = {
+        {kv::Op::Put, 1, 10}, {kv::Op::Put, 2, 20}, {kv::Op::Get, 1, 0},
+        {kv::Op::Put, 1, 11}, {kv::Op::Get, 1, 0},  {kv::Op::Del, 2, 0},
+        {kv::Op::Get, 2, 0},  {kv::Op::Del, 2, 0},  {kv::Op::Get, 3, 0},
+    };
+    const kv::Response expected[] = {
+        {kv::Status::Ok, 0},       {kv::Status::Ok, 0},
+        {kv::Status::Ok, 10},      {kv::Status::Ok, 0},
+        {kv::Status::Ok, 11},      {kv::Status::Ok, 0},
+        {kv::Status::NotFound, 0}, {kv::Status::NotFound, 0},
+        {kv::Status::NotFound, 0},
+    };
+    const std::size_t count = std::size(batch);
+
+    std::vector<unsigned char> in(count * kv::kRequestSize);
+    for (std::size_t i = 0; i < count; ++i) {
+        kv::encode(batch[i], in.data() + i * kv::kRequestSize);
+    }
+    SkipListMap<std::uint64_t, std::uint64_t> map;
+    std::vector<unsigned char> out(count * kv::kResponseSize);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto req = kv::decodeRequest(in.data() + i * kv::kRequestSize);
+        kv::encode(kv::execute(map, req),
+                   out.data() + i * kv::kResponseSize);
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        auto resp = kv::decodeResponse(out.data() + i * kv::kResponseSize);
+        assert(resp.status == expected[i].status);
+        assert(resp.value == expected[i].value);
+    }
+    assert(map.size() == 1 && map.find(1)->value == 11);
+    std::cout << "Ответы на " << count << " запросов пришли по порядку\n";
+
+    // Неизвестная операция отклоняется и не меняет данные
+    unsigned char frame[kv::kRequestSize];
+    kv::encode(kv::Request{kv::Op::Put, 5, 5}, frame);
+    frame[0] = 0x7f;
+    kv::Response bad = kv::execute(map, kv::decodeRequest(frame));
+    assert(bad.status == kv::Status::BadRequest);
+    assert(map.size() == 1 && !map.contains(5));
+}
+
+int main() {
+    demonstrateRoundTrip();
+    demonstratePipeline();
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "merkle_skip_list.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+void demonstrateDigests() {
+    std::cout << "\n=== Дайджесты ссылок ===\n";
+    MerkleSkipList<std::uint64_t> a;
+    MerkleSkipList<std::uint64_t> b;
+    std::vector<std::uint64_t> keys;
+    for (std::uint64_t i = 0; i < 5000; ++i) {
+        keys.push_back(i * 3);
+    }
+    for (std::uint64_t k : keys) {
+        a.insert(k);
+    }
+    std::mt19937 rng(5);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    for (std::uint64_t k : keys) {
+        b.insert(k);
+    }
+    assert(a.size() == 5000 && a.digest() == b.digest());
+    bool duplicate = a.insert(3);
+    assert(!duplicate && a.contains(3) && !a.contains(4));
+
+    // Вставка и удаление возвращают дайджест к исходному
+    std::uint64_t before = a.digest();
+    bool inserted = a.insert(4);
+    assert(inserted && a.digest() != before);
+    bool erased = a.erase(4);
+    bool erasedTwice = a.erase(4);
+    assert(erased && !erasedTwice && a.digest() == before);
+    assert(a.diff(b, [](std::uint64_t, bool) { assert(false); }) == 0);
+    std::cout << "Одинаковые наборы ключей дают одинаковый дайджест\n";
+}
+
+void demonstrateDiffAndSync() {
+    std::cout << "\n=== Поиск расхождений и синхронизация ===\n";
+    std::mt19937_64 rng(9);
+    MerkleSkipList<std::uint64_t> primary;
+    MerkleSkipList<std::uint64_t> replica;
+    std::set<std::uint64_t> p;
+    std::set<std::uint64_t> r;
+    for (int i = 0; i < 100000; ++i) {
+        std::uint64_t key = rng() % 1000000;
+        primary.insert(key);
+        replica.insert(key);
+        p.insert(key);
+        r.insert(key);
+    }
+
+    // Реплика отстала: часть ключей не дошла, часть лишних
+    for (int i = 0; i < 300; ++i) {
+        std::uint64_t key = rng() % 1000000;
+        if (i % 3 == 0) {
+            primary.insert(key);
+            p.insert(key);
+        } else if (i % 3 == 1) {
+            replica.insert(key);
+            r.insert(key);
+        } else {
+            auto it = p.lower_bound(key);
+            if (it != p.end()) {
+                primary.erase(*it);
+                p.erase(it);
+            }
+        }
+    }
+
+    std::vector<std::uint64_t> expected;
+    std::set_symmetric_difference(p.begin(), p.end(), r.begin(), r.end(),
+                                  std::back_inserter(expected));
+    std::vector<std::uint64_t> found;
+    std::size_t count = replica.diff(primary, [&](std::uint64_t k, bool in) {
+        assert(in == (r.count(k) == 1));
+        found.push_back(k);
+    });
+    assert(count == expected.size() && found == expected);
+    std::cout << "Найдено расхождений: " << count << '\n';
+
+    std::size_t synced = replica.syncFrom(primary);
+    assert(synced == expected.size());
+    assert(replica.digest() == primary.digest());
+    assert(replica.size() == primary.size());
+    assert(std::equal(replica.begin(), replica.end(), p.begin(), p.end()));
+    synced = replica.syncFrom(primary);
+    assert(synced == 0);
+
+    MerkleSkipList<std::uint64_t> empty;
+    assert(empty.diff(primary, [](std::uint64_t, bool) {}) == p.size());
+    std::cout << "Реплика синхронизирована\n";
+}
+
+int main() {
+    demonstrateDigests();
+    demonstrateDiffAndSync();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
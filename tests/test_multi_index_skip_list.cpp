@@ -0,0 +1,107 @@
+#include "allocation_counter.hpp"
+#include "multi_index_skip_list.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Person {
+    int id;
+    int age;
+    double score;
+};
+
+struct ById {
+    bool operator()(const Person &a, const Person &b) const {
+        return a.id < b.id;
+    }
+};
+
+struct ByAge {
+    bool operator()(const Person &a, const Person &b) const {
+        return a.age < b.age;
+    }
+};
+
+struct ByScoreDesc {
+    bool operator()(const Person &a, const Person &b) const {
+        return a.score > b.score;
+    }
+};
+
+using People = MultiIndexSkipList<Person, ById, ByAge, ByScoreDesc>;
+
+template <std::size_t I, typename Less>
+void checkOrder(const People &people, std::vector<Person> expected,
+                Less less) {
+    std::stable_sort(expected.begin(), expected.end(), less);
+    auto it = people.begin<I>();
+    for (const Person &p : expected) {
+        assert(it != people.end<I>() && it->id == p.id);
+        ++it;
+    }
+    assert(it == people.end<I>());
+}
+
+void demonstrateMultiIndex() {
+    std::cout << "\n=== Несколько индексов над одними записями ===\n";
+    People people;
+    std::vector<Person> all;
+    std::mt19937 rng(8);
+    std::vector<int> ids(5000);
+    for (int i = 0; i < 5000; ++i) {
+        ids[i] = i;
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    all.reserve(ids.size());
+
+    std::size_t before = allocations();
+    for (int id : ids) {
+        Person p{id, 18 + static_cast<int>(rng() % 60),
+                 static_cast<double>(rng() % 1000) / 10.0};
+        bool inserted = people.insert(p).second;
+        assert(inserted);
+        all.push_back(p);
+    }
+    // Одна запись — одно выделение
+    assert(allocations() - before == ids.size());
+    std::cout << "Записей: " << people.size() << ", выделений памяти: "
+              << allocations() - before << '\n';
+
+    auto [dup, inserted] = people.insert({42, 1, 0.0});
+    assert(!inserted && dup->id == 42 && dup->age != 1);
+
+    // Равные возраст и оценка упорядочены по id
+    std::sort(all.begin(), all.end(), ById());
+    checkOrder<0>(people, all, ById());
+    checkOrder<1>(people, all, ByAge());
+    checkOrder<2>(people, all, ByScoreDesc());
+
+    auto adults = people.lower_bound<1>({0, 30, 0.0});
+    assert(adults->age == 30 || adults->age > 30);
+    assert(people.find<1>({0, 200, 0.0}) == people.end<1>());
+
+    for (int id = 0; id < 5000; id += 2) {
+        bool erased = people.erase({id, 0, 0.0});
+        assert(erased);
+    }
+    bool erasedTwice = people.erase({0, 0, 0.0});
+    assert(!erasedTwice);
+    assert(people.size() == 2500 && !people.contains({10, 0, 0.0}));
+    all.erase(std::remove_if(all.begin(), all.end(),
+                             [](const Person &p) { return p.id % 2 == 0; }),
+              all.end());
+    checkOrder<0>(people, all, ById());
+    checkOrder<1>(people, all, ByAge());
+    checkOrder<2>(people, all, ByScoreDesc());
+    std::cout << "Удаление обновляет все индексы\n";
+}
+
+int main() {
+    demonstrateMultiIndex();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "order_book.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+void demonstrateRestingAndBest() {
+    std::cout << "\n=== Лучшие цены ===\n";
+    OrderBook book;
+    assert(!book.bestBid() && !book.bestAsk());
+
+    book.submit({1, Side::Buy, 100, 10});
+    book.submit({2, Side::Buy, 101, 5});
+    book.submit({3, Side::Sell, 105, 7});
+    book.submit({4, Side::Sell, 103, 2});
+
+    assert(*book.bestBid() == 101);
+    assert(*book.bestAsk() == 103);
+    assert(book.bids().levelCount() == 2);
+    assert(book.orderCount() == 4);
+    std::cout << "bid " << *book.bestBid() << " / ask " << *book.bestAsk()
+              << '\n';
+}
+
+void demonstrateMatching() {
+    std::cout << "\n=== Исполнение по приоритету цены и времени ===\n";
+    OrderBook book;
+    book.submit({1, Side::Sell, 100, 5});
+    book.submit({2, Side::Sell, 100, 5});
+    book.submit({3, Side::Sell, 101, 5});
+
+    auto trades = book.submit({10, Side::Buy, 101, 12});
+    assert(trades.size() == 3);
+    assert(trades[0].restingId == 1 && trades[0].quantity == 5);
+    assert(trades[1].restingId == 2 && trades[1].quantity == 5);
+    assert(trades[2].restingId == 3 && trades[2].quantity == 2);
+    assert(trades[2].price == 101);
+    assert(*book.bestAsk() == 101);
+    assert(book.asks().quantityAt(101) == 3);
+    assert(!book.bestBid());
+
+    // Остаток агрессивной заявки встаёт в стакан
+    trades = book.submit({11, Side::Buy, 102, 10});
+    assert(trades.size() == 1 && trades[0].quantity == 3);
+    assert(!book.bestAsk());
+    assert(*book.bestBid() == 102);
+    assert(book.bids().quantityAt(102) == 7);
+    std::cout << "Сделок исполнено, остаток на bid " << *book.bestBid()
+              << '\n';
+}
+
+void demonstrateCancel() {
+    std::cout << "\n=== Отмена по идентификатору ===\n";
+    OrderBook book;
+    book.submit({1, Side::Buy, 99, 4});
+    book.submit({2, Side::Buy, 99, 6});
+    book.submit({3, Side::Buy, 98, 1});
+
+    bool cancelled = book.cancel(1);
+    bool cancelledTwice = book.cancel(1);
+    assert(cancelled && !cancelledTwice);
+    assert(book.bids().quantityAt(99) == 6);
+    cancelled = book.cancel(2);
+    assert(cancelled && *book.bestBid() == 98);
+    assert(book.bids().levelCount() == 1);
+
+    std::vector<Trade> trades;
+    bool accepted = book.submit({3, Side::Sell, 200, 1}, trades);
+    assert(!accepted); // id уже занят
+    std::cout << "Осталось заявок: " << book.orderCount() << '\n';
+}
+
+void demonstrateExtremePrices() {
+    std::cout << "\n=== Крайние цены ===\n";
+    const std::int64_t lowest = std::numeric_limits<std::int64_t>::min();
+    const std::int64_t highest = std::numeric_limits<std::int64_t>::max();
+    OrderBook book;
+    book.submit({1, Side::Buy, lowest, 1});
+    book.submit({2, Side::Buy, highest, 2});
+    book.submit({3, Side::Buy, 0, 3});
+    assert(*book.bestBid() == highest);
+    assert(book.bids().quantityAt(lowest) == 1);
+
+    // Заявка на продажу по минимальной цене забирает все покупки
+    auto trades = book.submit({4, Side::Sell, lowest, 6});
+    assert(trades.size() == 3);
+    assert(trades[0].price == highest && trades[2].price == lowest);
+    assert(!book.bestBid() && !book.bestAsk());
+    std::cout << "Цены от INT64_MIN до INT64_MAX упорядочены верно\n";
+}
+
+int main() {
+    demonstrateRestingAndBest();
+    demonstrateMatching();
+    demonstrateCancel();
+    demonstrateExtremePrices();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include "parallel_set_ops.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+void demonstrateAppend() {
+    std::cout << "\n=== Склейка списков ===\n";
+    SkipList<int> head;
+    SkipList<int> tail;
+    for (int i = 0; i < 1000; ++i) {
+        head.insert(i);
+        tail.insert(1000 + i);
+    }
+    head.append(std::move(tail));
+    assert(head.size() == 2000 && tail.empty());
+    int expected = 0;
+    for (int key : head) {
+        assert(key == expected);
+        ++expected;
+    }
+    assert(expected == 2000);
+    assert(head.contains(1500) && head.lower_bound(999) != head.end());
+
+    // Опустевший хвост снова пригоден к работе
+    tail.insert(5);
+    assert(tail.size() == 1 && *tail.begin() == 5);
+
+    // Пустой список принимает хвост целиком
+    SkipList<int> empty;
+    head.append(std::move(empty));
+    empty.append(std::move(head));
+    assert(empty.size() == 2000 && head.empty());
+    std::cout << "Списки склеены за O(log n)\n";
+}
+
+void demonstrateSampling() {
+    std::cout << "\n=== Выборка разделителей ===\n";
+    SkipList<int> list;
+    for (int i = 0; i < 100000; ++i) {
+        list.insert(i);
+    }
+    std::vector<int> keys = list.sampleKeys(16);
+    assert(!keys.empty() && keys.size() <= 16);
+    assert(std::is_sorted(keys.begin(), keys.end()));
+    // Ключи разбросаны по всему списку, а не собраны в его начале
+    assert(keys.back() > 50000);
+    std::cout << "Выбрано " << keys.size() << " ключей из верхних уровней\n";
+
+    SkipList<int> small;
+    small.insert(1);
+    small.insert(2);
+    assert(small.sampleKeys(10).size() == 2);
+    assert(SkipList<int>().sampleKeys(10).empty());
+}
+
+void demonstrateParallelOps() {
+    std::cout << "\n=== Параллельные объединение и пересечение ===\n";
+    std::mt19937 rng(11);
+    const std::uint32_t universe = 300000;
+    const double density[] = {0.4, 0.05, 0.2};
+
+    std::vector<SkipList<std::uint32_t>> lists(3);
+    std::vector<std::vector<std::uint32_t>> sorted(3);
+    for (int l = 0; l < 3; ++l) {
+        std::bernoulli_distribution take(density[l]);
+        for (std::uint32_t key = 0; key < universe; ++key) {
+            if (take(rng)) {
+                sorted[l].push_back(key);
+            }
+        }
+        lists[l].insertSorted(sorted[l].begin(), sorted[l].end());
+    }
+
+    std::vector<std::uint32_t> united = sorted[0];
+    std::vector<std::uint32_t> common = sorted[0];
+    for (int l = 1; l < 3; ++l) {
+        std::vector<std::uint32_t> u;
+        std::vector<std::uint32_t> c;
+        std::set_union(united.begin(), united.end(), sorted[l].begin(),
+                       sorted[l].end(), std::back_inserter(u));
+        std::set_intersection(common.begin(), common.end(), sorted[l].begin(),
+                              sorted[l].end(), std::back_inserter(c));
+        united.swap(u);
+        common.swap(c);
+    }
+
+    std::vector<const SkipList<std::uint32_t> *> all{&lists[0], &lists[1],
+                                                     &lists[2]};
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        SkipList<std::uint32_t> u = parallelUnite(all, threads);
+        SkipList<std::uint32_t> c = parallelIntersect(all, threads);
+        assert(u.size() == united.size());
+        assert(std::equal(u.begin(), u.end(), united.begin(), united.end()));
+        assert(c.size() == common.size());
+        assert(std::equal(c.begin(), c.end(), common.begin(), common.end()));
+        // Результат - обычный список: поиск по склеенным сегментам работает
+        for (std::uint32_t key = 0; key < universe; key += 997) {
+            assert(u.contains(key) ==
+                   std::binary_search(united.begin(), united.end(), key));
+        }
+    }
+    std::cout << "Объединение: " << united.size()
+              << " ключей, пересечение: " << common.size() << " ключей\n";
+
+    // Слияние двух списков с непересекающимися диапазонами
+    SkipList<std::uint32_t> low;
+    SkipList<std::uint32_t> high;
+    for (std::uint32_t i = 0; i < 5000; ++i) {
+        low.insert(i);
+        high.insert(100000 + i);
+    }
+    using Lists = std::vector<const SkipList<std::uint32_t> *>;
+    SkipList<std::uint32_t> merged = parallelUnite(Lists{&low, &high}, 4);
+    assert(merged.size() == 10000);
+    assert(std::is_sorted(merged.begin(), merged.end()));
+    assert(parallelIntersect(Lists{&low, &high}, 4).empty());
+
+    SkipList<std::uint32_t> none;
+    assert(parallelUnite(Lists{&none, &none}, 4).empty());
+    assert(parallelIntersect(Lists{&low, &none}, 4).empty());
+    assert(parallelIntersect(Lists()).empty());
+    std::cout << "Результаты совпадают с std::set_union/set_intersection\n";
+}
+
+int main() {
+    demonstrateAppend();
+    demonstrateSampling();
+    demonstrateParallelOps();
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "partitioned_skip_list.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+using Partitioned = PartitionedSkipList<std::uint64_t>;
+
+void demonstratePointOps() {
+    std::cout << "\n=== Разделы по диапазонам ключей ===\n";
+    Partitioned set({1000, 2000, 3000}, 1, 16);
+    assert(set.partitionCount() == 4);
+    assert(set.partitionOf(999) == 0 && set.partitionOf(1000) == 1);
+    assert(set.partitionOf(5000) == 3);
+
+    auto &client = set.client(0);
+    std::set<std::uint64_t> reference;
+    std::mt19937_64 rng(3);
+    for (int step = 0; step < 20000; ++step) {
+        std::uint64_t key = rng() % 4000;
+        switch (rng() % 3) {
+        case 0: {
+            bool erased = reference.erase(key) == 1;
+            bool result = client.erase(key);
+            assert(result == erased);
+            break;
+        }
+        case 1:
+            assert(client.contains(key) == (reference.count(key) == 1));
+            break;
+        default:
+            bool inserted = reference.insert(key).second;
+            bool result = client.insert(key);
+            assert(result == inserted);
+        }
+    }
+    assert(client.size() == reference.size());
+
+    // Упорядоченный просмотр через границы разделов, кольцо меньше ответа
+    std::vector<std::uint64_t> keys;
+    client.scan(500, 3500, [&](std::uint64_t key) { keys.push_back(key); });
+    assert(keys == std::vector<std::uint64_t>(reference.lower_bound(500),
+                                              reference.lower_bound(3500)));
+    keys.clear();
+    client.scan(1000, 2000, [&](std::uint64_t key) { keys.push_back(key); });
+    assert(keys == std::vector<std::uint64_t>(reference.lower_bound(1000),
+                                              reference.lower_bound(2000)));
+    std::cout << "Ключей: " << client.size() << " в "
+              << set.partitionCount() << " разделах\n";
+}
+
+void demonstrateBatches() {
+    std::cout << "\n=== Пакетные запросы ===\n";
+    Partitioned set({250, 500, 750}, 1, 8);
+    auto &client = set.client(0);
+
+    // Пакет больше кольца и с повторами одного ключа
+    std::vector<Partitioned::Op> ops;
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        ops.push_back({Partitioned::Op::Insert, key});
+    }
+    for (std::uint64_t key = 0; key < 1000; key += 2) {
+        ops.push_back({Partitioned::Op::Erase, key});
+        ops.push_back({Partitioned::Op::Erase, key});
+        ops.push_back({Partitioned::Op::Contains, key + 1});
+    }
+    std::vector<bool> results = client.apply(ops);
+    for (std::size_t i = 0; i < 1000; ++i) {
+        assert(results[i]);
+    }
+    for (std::size_t i = 1000; i < ops.size(); i += 3) {
+        assert(results[i] && !results[i + 1] && results[i + 2]);
+    }
+    assert(client.size() == 500);
+    std::cout << "Пакет из " << ops.size() << " операций применён\n";
+}
+
+void demonstrateManyClients() {
+    std::cout << "\n=== Несколько клиентов ===\n";
+    constexpr unsigned kClients = 3;
+    Partitioned set({1 << 14, 1 << 15, 3 << 14}, kClients);
+
+    std::vector<std::thread> threads;
+    for (unsigned c = 0; c < kClients; ++c) {
+        threads.emplace_back([&set, c] {
+            auto &client = set.client(c);
+            std::vector<Partitioned::Op> ops;
+            for (std::uint64_t key = c; key < (1 << 16); key += kClients) {
+                ops.push_back({Partitioned::Op::Insert, key});
+            }
+            for (bool ok : client.apply(ops)) {
+                assert(ok);
+            }
+            for (std::uint64_t key = c; key < (1 << 16); key += 4 * kClients) {
+                bool erased = client.erase(key);
+                assert(erased);
+            }
+            std::uint64_t prev = 0;
+            bool first = true;
+            client.scan(0, 1 << 16, [&](std::uint64_t key) {
+                assert(first || key > prev);
+                prev = key;
+                first = false;
+            });
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    std::size_t count = 0;
+    set.client(0).scan(0, 1 << 16, [&](std::uint64_t key) {
+        assert((key / kClients) % 4 != 0);
+        ++count;
+    });
+    assert(count == set.client(0).size());
+    std::cout << "Осталось ключей: " << count << "\n";
+}
+
+int main() {
+    demonstratePointOps();
+    demonstrateBatches();
+    demonstrateManyClients();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
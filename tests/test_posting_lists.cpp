@@ -0,0 +1,88 @@
+#include "posting_lists.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+void demonstrateFingerSeek() {
+    std::cout << "\n=== Поиск от пальца ===\n";
+    SkipList<std::uint32_t> list;
+    for (std::uint32_t i = 0; i < 1000; i += 3) {
+        list.insert(i);
+    }
+    auto finger = list.finger();
+    for (std::uint32_t key = 0; key < 1005; key += 7) {
+        auto it = list.seek(finger, key);
+        assert(it == list.lower_bound(key));
+    }
+
+    // Список может расти, пока палец используется
+    auto grow = list.finger();
+    assert(*list.seek(grow, 100) == 102);
+    for (std::uint32_t i = 1; i < 100000; i += 3) {
+        list.insert(i);
+    }
+    assert(*list.seek(grow, 103) == 103);
+    assert(list.seek(grow, 200000) == list.end());
+    std::cout << "seek() совпадает с lower_bound()\n";
+}
+
+void demonstrateIntersection() {
+    std::cout << "\n=== Пересечение и объединение ===\n";
+    std::mt19937 rng(7);
+    const std::uint32_t universe = 200000;
+    const double density[] = {0.5, 0.1, 0.02, 0.3};
+
+    std::vector<SkipList<std::uint32_t>> lists(4);
+    std::vector<std::vector<std::uint32_t>> sorted(4);
+    for (int l = 0; l < 4; ++l) {
+        std::bernoulli_distribution take(density[l]);
+        for (std::uint32_t doc = 0; doc < universe; ++doc) {
+            if (take(rng)) {
+                sorted[l].push_back(doc);
+            }
+        }
+        lists[l].insertSorted(sorted[l].begin(), sorted[l].end());
+    }
+
+    std::vector<std::uint32_t> expected = sorted[0];
+    for (int l = 1; l < 4; ++l) {
+        std::vector<std::uint32_t> next;
+        std::set_intersection(expected.begin(), expected.end(),
+                              sorted[l].begin(), sorted[l].end(),
+                              std::back_inserter(next));
+        expected.swap(next);
+    }
+    std::vector<const SkipList<std::uint32_t> *> all{&lists[0], &lists[1],
+                                                     &lists[2], &lists[3]};
+    assert(intersectLists(all) == expected);
+    std::cout << "Пересечение 4 списков: " << expected.size()
+              << " документов\n";
+
+    std::vector<std::uint32_t> united;
+    for (int l = 0; l < 4; ++l) {
+        std::vector<std::uint32_t> next;
+        std::set_union(united.begin(), united.end(), sorted[l].begin(),
+                       sorted[l].end(), std::back_inserter(next));
+        united.swap(next);
+    }
+    assert(uniteLists(all) == united);
+    std::cout << "Объединение 4 списков: " << united.size()
+              << " документов\n";
+
+    SkipList<std::uint32_t> empty;
+    assert(intersectLists<std::uint32_t>({&lists[0], &empty}).empty());
+    assert(intersectLists<std::uint32_t>({&lists[1]}) == sorted[1]);
+    assert(uniteLists<std::uint32_t>({&empty}).empty());
+}
+
+int main() {
+    demonstrateFingerSeek();
+    demonstrateIntersection();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
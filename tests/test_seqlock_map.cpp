@@ -0,0 +1,142 @@
+#include "seqlock_map.hpp"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/// Значение из двух полей: чтение половины записи сразу заметно
+struct Pair {
+    std::uint64_t a;
+    std::uint64_t b; ///< Всегда 2 * a
+};
+
+void demonstrateSeqlockValue() {
+    std::cout << "\n=== Значение под seqlock ===\n";
+    SeqlockValue<Pair> value(Pair{1, 2});
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> reads{0};
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            Pair p = value.load();
+            assert(p.b == 2 * p.a);
+            reads.fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 2; ++t) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 100000; ++i) {
+                value.update([](Pair &p) {
+                    ++p.a;
+                    p.b = 2 * p.a;
+                });
+            }
+        });
+    }
+    for (std::thread &w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+
+    assert(value.load().a == 200001);
+    std::cout << "Чтений без разорванных значений: " << reads.load() << "\n";
+}
+
+void demonstrateCounters() {
+    std::cout << "\n=== Счётчики в карте ===\n";
+    SeqlockSkipListMap<int, Pair> counters;
+    constexpr int kKeys = 64;
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 20000;
+    for (int k = 0; k < kKeys; ++k) {
+        bool inserted = counters.insert(k, Pair{0, 0});
+        assert(inserted);
+    }
+    bool duplicate = counters.insert(0, Pair{5, 10});
+    assert(!duplicate);
+
+    std::atomic<bool> done{false};
+    // Читатель проверяет целостность значений, а поток структуры вставляет
+    // и удаляет ключи вне диапазона счётчиков
+    std::thread reader([&] {
+        while (!done.load()) {
+            for (int k = 0; k < kKeys; ++k) {
+                auto p = counters.load(k);
+                assert(p && p->b == 2 * p->a);
+            }
+        }
+    });
+    std::thread structure([&] {
+        for (int i = 0; !done.load(); ++i) {
+            int key = kKeys + i % 1000;
+            if (!counters.insert(key, Pair{1, 2})) {
+                bool erased = counters.erase(key);
+                assert(erased);
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < kThreads; ++t) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < kRounds; ++i) {
+                int key = (i * kThreads + t) % kKeys;
+                bool updated = counters.update(key, [](Pair &p) {
+                    ++p.a;
+                    p.b += 2;
+                });
+                assert(updated);
+            }
+        });
+    }
+    for (std::thread &w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+    structure.join();
+
+    std::uint64_t total = 0;
+    counters.forEach([&](int key, const Pair &p) {
+        if (key < kKeys) {
+            total += p.a;
+        }
+    });
+    assert(total == static_cast<std::uint64_t>(kThreads) * kRounds);
+    std::cout << "Сумма счётчиков: " << total << "\n";
+}
+
+void demonstrateUpsert() {
+    std::cout << "\n=== Вставка или обновление ===\n";
+    SeqlockSkipListMap<int, std::uint64_t> hits;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&hits] {
+            for (int i = 0; i < 10000; ++i) {
+                hits.upsert(i % 100, 0, [](std::uint64_t &n) { ++n; });
+            }
+        });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    assert(hits.size() == 100);
+    hits.forEach([](int, std::uint64_t n) { assert(n == 400); });
+    bool stored = hits.store(7, 1);
+    assert(stored && hits.load(7) == 1u);
+    stored = hits.store(1000, 1);
+    assert(!stored && !hits.load(1000));
+    std::cout << "Каждый из 100 ключей увеличен 400 раз\n";
+}
+
+int main() {
+    demonstrateSeqlockValue();
+    demonstrateCounters();
+    demonstrateUpsert();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
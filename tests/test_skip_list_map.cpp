@@ -0,0 +1,135 @@
+#include "skip_list_map.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void demonstrateMapOperations() {
+    std::cout << "\n=== Скип-лист как словарь ===\n";
+    SkipListMap<int, std::string> map;
+
+    bool inserted = map.insert(2, "two");
+    assert(inserted);
+    inserted = map.insert(1, "one");
+    assert(inserted);
+    inserted = map.insert(3, "three");
+    assert(inserted);
+    inserted = map.insert(2, "два");
+    assert(!inserted); // ключ уже есть
+    assert(map.find(2)->value == "two");
+
+    inserted = map.insertOrAssign(2, "два");
+    assert(!inserted);
+    inserted = map.insertOrAssign(4, "четыре");
+    assert(inserted);
+    assert(map.find(2)->value == "два");
+    assert(map.size() == 4);
+
+    bool erased = map.erase(1);
+    bool erasedTwice = map.erase(1);
+    assert(erased && !erasedTwice);
+    assert(!map.contains(1));
+    assert(map.find(1) == map.end());
+    assert(map.lower_bound(1)->key == 2);
+
+    std::cout << "Содержимое: ";
+    for (const auto &entry : map) {
+        std::cout << entry.key << '=' << entry.value << ' ';
+    }
+    std::cout << '\n';
+}
+
+void demonstrateInPlaceUpdate() {
+    std::cout << "\n=== Обновление значений на месте ===\n";
+    SkipListMap<std::uint64_t, std::uint64_t> counters;
+
+    for (std::uint64_t i = 0; i < 1000; ++i) {
+        auto it = counters.find(i % 10);
+        if (it == counters.end()) {
+            counters.insert(i % 10, 1);
+        } else {
+            ++it->value;
+        }
+    }
+    assert(counters.size() == 10);
+    for (const auto &entry : counters) {
+        assert(entry.value == 100);
+    }
+    std::cout << "Каждый из 10 счётчиков равен 100\n";
+}
+
+void demonstrateColumnExport() {
+    std::cout << "\n=== Выгрузка в столбцы ===\n";
+    SkipListMap<std::uint64_t, double> prices;
+    for (std::uint64_t id = 0; id < 1000; ++id) {
+        prices.insert(id * 2, id * 0.5);
+    }
+
+    std::vector<std::uint64_t> keys(100);
+    std::vector<double> values(100);
+    std::size_t n = prices.exportRange(501, 700, keys, values);
+    assert(n == 99 && keys[0] == 502 && keys[98] == 698);
+    assert(values[0] == 125.5 && values[98] == 174.5);
+
+    // Столбец значений короче: выгружается столько, сколько в него входит
+    n = prices.exportRange(0, 2000, keys, std::span<double>(values.data(), 10));
+    assert(n == 10 && keys[9] == 18 && values[9] == 4.5);
+
+    std::size_t chunks = 0;
+    std::uint64_t expectedKey = 100;
+    std::size_t total = prices.exportChunks(
+        100, 1100, std::span<std::uint64_t>(keys.data(), 64),
+        std::span<double>(values.data(), 64),
+        [&](std::span<const std::uint64_t> k, std::span<const double> v) {
+            assert(k.size() == v.size() && (k.size() == 64 || k.size() == 52));
+            for (std::size_t i = 0; i < k.size(); ++i) {
+                assert(k[i] == expectedKey && v[i] == expectedKey * 0.25);
+                expectedKey += 2;
+            }
+            ++chunks;
+        });
+    assert(total == 500 && chunks == 8 && expectedKey == 1100);
+    std::cout << "Выгружено " << total << " пар за " << chunks
+              << " порций\n";
+}
+
+void demonstrateLazyReinsert() {
+    std::cout << "\n=== Повторная вставка после ленивого удаления ===\n";
+    SkipListMap<int, int> map;
+    map.setLazyErase(true);
+
+    map.insertOrAssign(1, 100);
+    map.insert(2, 200);
+    map.emplace(3, 300);
+    for (int key = 1; key <= 3; ++key) {
+        bool erased = map.erase(key);
+        assert(erased);
+    }
+    assert(map.empty());
+
+    // Узлы оживают, но значения берутся из новой вставки
+    bool assigned = map.insertOrAssign(1, 111);
+    bool inserted = map.insert(2, 222);
+    auto [it, emplaced] = map.emplace(3, 333);
+    assert(assigned && inserted && emplaced && it->value == 333);
+    assert(map.size() == 3);
+    assert(map.find(1)->value == 111);
+    assert(map.find(2)->value == 222);
+    assert(map.find(3)->value == 333);
+
+    // Живой ключ по-прежнему не перезаписывается вставкой
+    inserted = map.insert(2, 999);
+    assert(!inserted && map.find(2)->value == 222);
+    std::cout << "После удаления и вставки читаются новые значения\n";
+}
+
+int main() {
+    demonstrateMapOperations();
+    demonstrateInPlaceUpdate();
+    demonstrateLazyReinsert();
+    demonstrateColumnExport();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "skip_trie.hpp"
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <set>
+#include <vector>
+
+/// Ожидаемый предшественник: последний ключ, не больший key
+bool samePredecessor(const SkipTrie &trie, const std::set<std::uint64_t> &set,
+                     std::uint64_t key) {
+    auto it = set.upper_bound(key);
+    if (it == set.begin()) {
+        return trie.predecessor(key) == trie.end();
+    }
+    auto found = trie.predecessor(key);
+    return found != trie.end() && *found == *std::prev(it);
+}
+
+void demonstrateRandomOps() {
+    std::cout << "\n=== Случайные операции против std::set ===\n";
+    SkipTrie trie;
+    std::set<std::uint64_t> reference;
+    std::mt19937_64 rng(11);
+    // Ключи из узкого диапазона и полные 64-битные вперемешку
+    auto nextKey = [&] { return rng() % 2 ? rng() % 100000 : rng(); };
+    for (int step = 0; step < 300000; ++step) {
+        std::uint64_t key = nextKey();
+        switch (rng() % 5) {
+        case 0: {
+            bool erased = reference.erase(key) == 1;
+            bool result = trie.erase(key);
+            assert(result == erased);
+            break;
+        }
+        case 1: {
+            std::uint64_t probe = nextKey();
+            auto it = trie.lower_bound(probe);
+            auto expected = reference.lower_bound(probe);
+            assert((it == trie.end()) == (expected == reference.end()));
+            assert(it == trie.end() || *it == *expected);
+            assert(samePredecessor(trie, reference, probe));
+            break;
+        }
+        default:
+            bool inserted = reference.insert(key).second;
+            bool result = trie.insert(key);
+            assert(result == inserted);
+        }
+    }
+    assert(trie.size() == reference.size());
+    assert(std::vector<std::uint64_t>(trie.begin(), trie.end()) ==
+           std::vector<std::uint64_t>(reference.begin(), reference.end()));
+    for (std::uint64_t key : reference) {
+        assert(trie.contains(key));
+        auto next = trie.upper_bound(key);
+        auto expected = reference.upper_bound(key);
+        assert(next == trie.end() ? expected == reference.end()
+                                  : *next == *expected);
+    }
+    assert(trie.topKeys() > 0 && trie.topKeys() < trie.size() / 8);
+    std::cout << "Ключей: " << trie.size() << ", в префиксном индексе: "
+              << trie.topKeys() << "\n";
+}
+
+void demonstrateExtremes() {
+    std::cout << "\n=== Крайние ключи ===\n";
+    constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+    SkipTrie trie;
+    assert(trie.lower_bound(0) == trie.end());
+    assert(trie.predecessor(kMax) == trie.end());
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        trie.insert(key);
+        trie.insert(kMax - key);
+    }
+    assert(*trie.predecessor(kMax) == kMax && *trie.lower_bound(0) == 0);
+    assert(*trie.lower_bound(1000) == kMax - 999);
+    assert(*trie.predecessor(kMax - 1000) == 999);
+    assert(trie.upper_bound(kMax) == trie.end());
+    for (std::uint64_t key = 0; key < 1000; ++key) {
+        bool low = trie.erase(key);
+        bool high = trie.erase(kMax - key);
+        assert(low && high);
+    }
+    assert(trie.empty() && trie.topKeys() == 0);
+    assert(trie.begin() == trie.end() && !trie.contains(0));
+    std::cout << "Ключи 0 и 2^64 - 1 обрабатываются корректно\n";
+}
+
+int main() {
+    demonstrateRandomOps();
+    demonstrateExtremes();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include "spatial_index.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <vector>
+
+void demonstrateEncoding() {
+    std::cout << "\n=== Кодирование Z-порядка ===\n";
+    assert(SpatialIndex::encode({0, 0}) == 0);
+    assert(SpatialIndex::encode({1, 0}) == 1);
+    assert(SpatialIndex::encode({0, 1}) == 2);
+    assert(SpatialIndex::encode({3, 3}) == 15);
+
+    GridPoint p{123456789, 987654321};
+    assert(SpatialIndex::decode(SpatialIndex::encode(p)) == p);
+
+    // BIGMIN сверяется с полным перебором на небольшой сетке
+    GridBox box{3, 5, 5, 10};
+    std::uint64_t zMin = SpatialIndex::encode({box.xMin, box.yMin});
+    std::uint64_t zMax = SpatialIndex::encode({box.xMax, box.yMax});
+    int checked = 0;
+    for (std::uint64_t z = zMin; z <= zMax; ++z) {
+        if (box.contains(SpatialIndex::decode(z))) {
+            continue;
+        }
+        ++checked;
+        std::uint64_t expected = z + 1;
+        while (!box.contains(SpatialIndex::decode(expected))) {
+            ++expected;
+        }
+        assert(SpatialIndex::bigMin(z, zMin, zMax) == expected);
+    }
+    std::cout << "BIGMIN совпал с перебором для " << checked
+              << " значений\n";
+}
+
+void demonstrateBoxQueries() {
+    std::cout << "\n=== Запросы по прямоугольнику ===\n";
+    SpatialIndex index;
+    std::vector<GridPoint> points;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::uint32_t> coord(0, 1000);
+    for (int i = 0; i < 20000; ++i) {
+        GridPoint p{coord(rng), coord(rng)};
+        if (index.insert(p)) {
+            points.push_back(p);
+        }
+    }
+    assert(index.size() == points.size());
+
+    for (int q = 0; q < 200; ++q) {
+        std::uint32_t x0 = coord(rng), x1 = coord(rng);
+        std::uint32_t y0 = coord(rng), y1 = coord(rng);
+        GridBox box{std::min(x0, x1), std::min(y0, y1), std::max(x0, x1),
+                    std::max(y0, y1)};
+
+        auto found = index.query(box);
+        std::size_t expected = std::count_if(
+            points.begin(), points.end(),
+            [&](const GridPoint &p) { return box.contains(p); });
+        assert(found.size() == expected);
+        for (const auto &p : found) {
+            assert(box.contains(p));
+        }
+    }
+
+    GridBox box{100, 100, 200, 150};
+    std::cout << "Точек в [100..200] x [100..150]: "
+              << index.query(box, [](const GridPoint &) {}) << '\n';
+}
+
+int main() {
+    demonstrateEncoding();
+    demonstrateBoxQueries();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "tenant_lists.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+void demonstrateTenants() {
+    std::cout << "\n=== Списки арендаторов в общей арене ===\n";
+    TenantLists<std::uint64_t> tenants(1 << 20);
+    std::mt19937_64 rng(11);
+    std::vector<std::set<std::uint64_t>> reference(100);
+
+    for (int step = 0; step < 50000; ++step) {
+        std::uint64_t id = rng() % reference.size();
+        std::uint64_t key = rng() % 500;
+        auto &list = tenants.open(id);
+        if (rng() % 3 == 0) {
+            bool erased = reference[id].erase(key) == 1;
+            bool result = list.erase(key);
+            assert(result == erased);
+        } else {
+            bool inserted = reference[id].insert(key).second;
+            bool result = list.insert(key).second;
+            assert(result == inserted);
+        }
+    }
+    for (std::uint64_t id = 0; id < reference.size(); ++id) {
+        auto *list = tenants.find(id);
+        assert(list);
+        assert(std::equal(list->begin(), list->end(), reference[id].begin(),
+                          reference[id].end()));
+        assert(tenants.usedBytes(id) > 0);
+        assert(tenants.usedBytes(id) <= tenants.reservedBytes(id));
+    }
+    assert(tenants.tenantCount() == reference.size());
+    assert(!tenants.find(reference.size()));
+    std::cout << "Арендаторов: " << tenants.tenantCount()
+              << ", чанков в арене: " << tenants.arena().chunksAllocated()
+              << "\n";
+}
+
+void demonstrateQuota() {
+    std::cout << "\n=== Квота арендатора ===\n";
+    // Высоты из хеша ключа: повторная вставка занимает столько же памяти
+    TenantLists<std::uint64_t> tenants(1 << 20, 4096, 0.5, 16,
+                                       LevelMode::Hashed);
+    auto &list = tenants.open(1, 4096);
+
+    std::uint64_t key = 0;
+    bool exceeded = false;
+    try {
+        for (;; ++key) {
+            list.insert(key);
+        }
+    } catch (const QuotaExceeded &) {
+        exceeded = true;
+    }
+    assert(exceeded);
+    assert(list.size() == key && !list.contains(key));
+    assert(tenants.usedBytes(1) <= 4096);
+    std::cout << "Квота 4096 байт вместила " << list.size() << " ключей\n";
+
+    // Неудачная вставка не испортила список, а удаление освобождает место
+    std::uint64_t expected = 0;
+    for (std::uint64_t k : list) {
+        assert(k == expected);
+        ++expected;
+    }
+    std::size_t used = tenants.usedBytes(1);
+    bool erased = list.erase(0);
+    assert(erased && tenants.usedBytes(1) < used);
+    bool inserted = list.insert(0).second;
+    assert(inserted);
+
+    // Соседний арендатор не ограничен чужой квотой
+    auto &other = tenants.open(2);
+    for (std::uint64_t k = 0; k < 10 * key; ++k) {
+        other.insert(k);
+    }
+    assert(other.size() == 10 * key);
+
+    bool raised = tenants.setQuota(1, 1 << 20);
+    inserted = list.insert(key).second;
+    assert(raised && inserted);
+    bool unknown = tenants.setQuota(3, 0);
+    assert(!unknown);
+}
+
+void demonstrateDrop() {
+    std::cout << "\n=== Удаление арендатора и переиспользование чанков ===\n";
+    TenantLists<std::uint64_t> tenants(1 << 20, 1024, 0.5, 16,
+                                       LevelMode::Hashed);
+    for (std::uint64_t id = 0; id < 10; ++id) {
+        auto &list = tenants.open(id);
+        for (std::uint64_t k = 0; k < 1000; ++k) {
+            list.insert(k * 7 + id);
+        }
+    }
+    std::size_t allocated = tenants.arena().chunksAllocated();
+    std::size_t reserved = tenants.reservedBytes(3);
+    assert(tenants.arena().chunksFree() == 0);
+
+    bool dropped = tenants.drop(3);
+    bool droppedTwice = tenants.drop(3);
+    assert(dropped && !droppedTwice && !tenants.find(3));
+    assert(tenants.usedBytes(3) == 0);
+    assert(tenants.arena().chunksFree() * 1024 == reserved);
+
+    // Новый арендатор с теми же ключами берёт освобождённые чанки, а не
+    // новую память
+    auto &list = tenants.open(42);
+    for (std::uint64_t k = 0; k < 1000; ++k) {
+        list.insert(k * 7 + 3);
+    }
+    assert(tenants.arena().chunksAllocated() == allocated);
+    assert(tenants.arena().chunksFree() == 0);
+    std::cout << "После удаления и нового арендатора чанков: "
+              << tenants.arena().chunksAllocated() << " (было " << allocated
+              << ")\n";
+}
+
+void demonstrateNonTrivialKeys() {
+    std::cout << "\n=== Ключи с деструктором ===\n";
+    TenantLists<std::string, std::string> tenants(1 << 20);
+    auto &list = tenants.open("alpha");
+    for (int i = 0; i < 1000; ++i) {
+        list.insert("key-with-a-long-enough-name-" + std::to_string(i));
+    }
+    assert(list.size() == 1000);
+    bool dropped = tenants.drop("alpha");
+    assert(dropped);
+    tenants.open("beta").insert("x");
+    std::cout << "Строковые ключи освобождены при удалении арендатора\n";
+}
+
+int main() {
+    demonstrateTenants();
+    demonstrateQuota();
+    demonstrateDrop();
+    demonstrateNonTrivialKeys();
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "timer_service.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+void demonstrateEraseBelow() {
+    std::cout << "\n=== Удаление префикса ===\n";
+    SkipList<int> list;
+    for (int i = 0; i < 1000; ++i) {
+        list.insert(i);
+    }
+    list.setLazyErase(true);
+    list.erase(list.find(10));
+    bool erasedTwice = list.erase(list.find(10));
+    assert(!erasedTwice && !list.contains(10));
+
+    std::vector<int> removed;
+    std::size_t cut =
+        list.eraseBelow(100, [&](int k) { removed.push_back(k); });
+    assert(cut == 99);
+    assert(removed.size() == 99 && removed.front() == 0 &&
+           removed.back() == 99);
+    assert(list.size() == 900);
+    assert(*list.begin() == 100);
+    cut = list.eraseBelow(50, [](int) {});
+    std::size_t purged = list.purge();
+    assert(cut == 0);
+    assert(purged == 0); // помеченный узел ушёл вместе с префиксом
+
+    cut = list.eraseBelow(5000, [](int) {});
+    assert(cut == 900 && list.empty() && list.begin() == list.end());
+    list.insert(7);
+    assert(list.size() == 1 && *list.begin() == 7);
+    std::cout << "Префикс вырезается за один проход\n";
+}
+
+void demonstrateTimers() {
+    std::cout << "\n=== Таймеры ===\n";
+    TimerService timers;
+    std::vector<std::uint64_t> fired;
+    auto collect = [&](std::uint64_t payload) { fired.push_back(payload); };
+
+    TimerHandle a = timers.schedule(30, 1);
+    TimerHandle b = timers.schedule(10, 2);
+    timers.schedule(20, 3);
+    timers.schedule(10, 4);
+    assert(timers.size() == 4 && timers.bucketCount() == 3);
+    assert(*timers.nextDeadline() == 10);
+
+    bool cancelled = timers.cancel(b);
+    bool cancelledTwice = timers.cancel(b);
+    assert(cancelled && !cancelledTwice);
+    std::size_t expired = timers.popExpired(20, collect);
+    assert(expired == 2 && (fired == std::vector<std::uint64_t>{4, 3}));
+    cancelled = timers.cancel(a);
+    assert(cancelled && timers.empty() && !timers.nextDeadline());
+
+    std::cout << "Отмена и срабатывание по дедлайнам работают\n";
+}
+
+void checkAgainstReference(std::uint64_t resolution) {
+    TimerService timers(resolution);
+    std::mt19937 rng(3);
+    // id -> округлённый дедлайн ещё не сработавших таймеров
+    std::map<std::uint64_t, std::uint64_t> pending;
+    std::vector<TimerHandle> handles;
+    std::vector<std::uint64_t> fired;
+    std::uint64_t now = 0;
+
+    for (std::uint64_t id = 0; id < 20000; ++id) {
+        std::uint64_t deadline = now + 1 + rng() % 500;
+        handles.push_back(timers.schedule(deadline, id));
+        pending[id] = (deadline + resolution - 1) / resolution * resolution;
+
+        std::uint64_t victim = rng() % handles.size();
+        bool expected = pending.erase(victim) == 1;
+        bool cancelled = timers.cancel(handles[victim]);
+        assert(cancelled == expected);
+
+        if (id % 100 == 99) {
+            now += 50;
+            std::vector<std::pair<std::uint64_t, std::uint64_t>> due;
+            for (auto it = pending.begin(); it != pending.end();) {
+                if (it->second <= now) {
+                    due.push_back({it->second, it->first});
+                    it = pending.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            std::sort(due.begin(), due.end());
+            fired.clear();
+            timers.popExpired(now,
+                              [&](std::uint64_t p) { fired.push_back(p); });
+            assert(fired.size() == due.size());
+            for (std::size_t i = 0; i < due.size(); ++i) {
+                assert(fired[i] == due[i].second);
+            }
+            for (std::uint64_t p : fired) {
+                bool cancelled = timers.cancel(handles[p]);
+                assert(!cancelled);
+            }
+        }
+        assert(timers.size() == pending.size());
+    }
+    std::cout << "Шаг " << resolution << ": совпадение с эталоном, корзин "
+              << timers.bucketCount() << " на " << timers.size()
+              << " таймеров\n";
+}
+
+int main() {
+    demonstrateEraseBelow();
+    demonstrateTimers();
+    checkAgainstReference(1);
+    checkAgainstReference(16);
+
+    std::cout << "\nВсе тесты пройдены успешно.\n";
+    return 0;
+}